@@ -0,0 +1,296 @@
+/* GF2 benchmark - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later and CP2130 simulator class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "cp2130sim.h"
+#include "gf2device.h"
+#include "gf2json.h"
+
+// Definitions
+const int ITERATIONS = 1000;                             // Default number of measured calls per benchmark
+const int HELPER_BATCH = 1000;                           // Number of calls timed together, for the helpers that do not involve transfers
+const size_t SPI_SIZES[] = {8, 56, 512, 4096};           // Transfer sizes used by the SPI benchmarks
+const uint8_t EPIN = 0x82;                               // Address of endpoint assuming the IN direction
+const uint8_t EPOUT = 0x01;                              // Address of endpoint assuming the OUT direction
+
+// Result of a single benchmark
+struct Result {
+    std::string name;
+    int iterations;
+    size_t bytes;
+    double mean, min, p50, p99, max;  // Per-call latencies, in nanoseconds
+    double transfers;                 // Average number of USB transfers per call
+    int errors;
+};
+
+// Options given via the command line
+struct Options {
+    bool hardware;
+    std::string serial;
+    int iterations;
+    uint32_t latency;
+};
+
+// Times the given function, "iterations" samples of "batch" calls each, and returns the per-call statistics
+// The number of transfers is obtained from the statistics of the device, before and after the run
+static Result measure(const std::string &name, int iterations, int batch, size_t bytes, const std::function<void(int &, std::string &)> &function, const std::function<CP2130::Statistics()> &statistics, std::string &errstr)
+{
+    std::vector<double> samples(static_cast<size_t>(iterations));
+    int errcnt = 0;
+    function(errcnt, errstr);  // Warm-up call, not measured
+    CP2130::Statistics before = statistics();
+    for (int i = 0; i < iterations; ++i) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (int j = 0; j < batch; ++j) {
+            function(errcnt, errstr);
+        }
+        samples[i] = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()) / batch;
+    }
+    CP2130::Statistics after = statistics();
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    Result result;
+    result.name = name;
+    result.iterations = iterations * batch;
+    result.bytes = bytes;
+    result.mean = sum / iterations;
+    result.min = samples.front();
+    result.p50 = samples[samples.size() / 2];
+    result.p99 = samples[samples.size() * 99 / 100];
+    result.max = samples.back();
+    result.transfers = static_cast<double>(after.controlTransfers + after.bulkTransfers - before.controlTransfers - before.bulkTransfers) / (iterations * batch);
+    result.errors = errcnt;
+    return result;
+}
+
+// Runs the benchmarks that go through the GF2Device class
+static void benchmarkDevice(GF2Device &device, const Options &options, std::vector<Result> &results, std::string &errstr)
+{
+    std::function<CP2130::Statistics()> statistics = [&device]() { return device.getStatistics(); };
+    float frequency = 0;
+    float phase = 0;
+    float amplitude = 0;
+    int setupErrcnt = 0;
+    device.setupChannel0(setupErrcnt, errstr);
+    device.setupChannel1(setupErrcnt, errstr);
+    results.push_back(measure("GF2Device::setFrequency", options.iterations, 1, 0, [&device, &frequency](int &errcnt, std::string &errstr) {
+        frequency = frequency >= GF2Device::FREQUENCY_MAX ? 0 : frequency + 1.25f;  // Varied, so that no caching can hide the cost of the call
+        device.setFrequency(GF2Device::FSEL0, frequency, errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::setPhase", options.iterations, 1, 0, [&device, &phase](int &errcnt, std::string &errstr) {
+        phase = phase >= 360 ? 0 : phase + 0.5f;
+        device.setPhase(GF2Device::PSEL0, phase, errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::setAmplitude", options.iterations, 1, 0, [&device, &amplitude](int &errcnt, std::string &errstr) {
+        amplitude = amplitude >= GF2Device::AMPLITUDE_MAX ? 0 : amplitude + 0.01f;
+        device.setAmplitude(amplitude, errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::clear", options.iterations, 1, 0, [&device](int &errcnt, std::string &errstr) {
+        device.clear(errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::start", options.iterations, 1, 0, [&device](int &errcnt, std::string &errstr) {
+        device.start(errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::stop", options.iterations, 1, 0, [&device](int &errcnt, std::string &errstr) {
+        device.stop(errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::isWaveGenEnabled", options.iterations, 1, 0, [&device](int &errcnt, std::string &errstr) {
+        device.isWaveGenEnabled(errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::getStatus", options.iterations, 1, 0, [&device](int &errcnt, std::string &errstr) {
+        device.getStatus(errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::setWaveGenEnabled", options.iterations, 1, 0, [&device](int &errcnt, std::string &errstr) {
+        device.setWaveGenEnabled(false, errcnt, errstr);
+    }, statistics, errstr));
+    if (setupErrcnt > 0) {
+        results.push_back({"GF2Device::setupChannel", 2, 0, 0, 0, 0, 0, 0, 0, setupErrcnt});
+    }
+}
+
+// Runs the benchmarks that go directly through the CP2130 class
+// Note that SPI transfers are done with all chip selects disabled, so that neither the AD9834 nor the AD5310 are affected, if using real hardware
+static void benchmarkCP2130(CP2130 &cp2130, const Options &options, std::vector<Result> &results, std::string &errstr)
+{
+    std::function<CP2130::Statistics()> statistics = [&cp2130]() { return cp2130.getStatistics(); };
+    int setupErrcnt = 0;
+    cp2130.disableCS(0, setupErrcnt, errstr);
+    cp2130.disableCS(1, setupErrcnt, errstr);
+    results.push_back(measure("CP2130::getGPIOs", options.iterations, 1, 0, [&cp2130](int &errcnt, std::string &errstr) {
+        cp2130.getGPIOs(errcnt, errstr);
+    }, statistics, errstr));
+    results.push_back(measure("CP2130::setGPIOs", options.iterations, 1, 0, [&cp2130](int &errcnt, std::string &errstr) {
+        cp2130.setGPIOs(0x0000, 0x0000, errcnt, errstr);  // Empty mask, so that no pin is changed
+    }, statistics, errstr));
+    for (size_t size : SPI_SIZES) {
+        std::vector<uint8_t> data(size, 0x55);
+        std::string suffix = "/" + std::to_string(size);
+        results.push_back(measure("CP2130::spiWrite" + suffix, options.iterations, 1, size, [&cp2130, data](int &errcnt, std::string &errstr) {
+            cp2130.spiWrite(data, EPOUT, errcnt, errstr);
+        }, statistics, errstr));
+        results.push_back(measure("CP2130::spiRead" + suffix, options.iterations, 1, size, [&cp2130, size](int &errcnt, std::string &errstr) {
+            cp2130.spiRead(static_cast<uint32_t>(size), EPIN, EPOUT, errcnt, errstr);
+        }, statistics, errstr));
+        results.push_back(measure("CP2130::spiWriteRead" + suffix, options.iterations, 1, size, [&cp2130, data](int &errcnt, std::string &errstr) {
+            cp2130.spiWriteRead(data, EPIN, EPOUT, errcnt, errstr);
+        }, statistics, errstr));
+    }
+    if (setupErrcnt > 0) {
+        results.push_back({"CP2130::disableCS", 2, 0, 0, 0, 0, 0, 0, 0, setupErrcnt});
+    }
+}
+
+// Runs the benchmarks of the helpers, which do not involve any transfers
+static void benchmarkHelpers(const Options &options, std::vector<Result> &results, std::string &errstr)
+{
+    std::function<CP2130::Statistics()> statistics = []() { return CP2130::Statistics(); };
+    volatile float sink = 0;  // Prevents the calls from being optimized away
+    float value = 0;
+    results.push_back(measure("GF2Device::expectedFrequency", options.iterations, HELPER_BATCH, 0, [&sink, &value](int &, std::string &) {
+        value = value >= GF2Device::FREQUENCY_MAX ? 0 : value + 0.125f;
+        sink = GF2Device::expectedFrequency(value);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::expectedPhase", options.iterations, HELPER_BATCH, 0, [&sink, &value](int &, std::string &) {
+        value = value >= 720 ? -720 : value + 0.125f;
+        sink = GF2Device::expectedPhase(value);
+    }, statistics, errstr));
+    results.push_back(measure("GF2Device::expectedAmplitude", options.iterations, HELPER_BATCH, 0, [&sink, &value](int &, std::string &) {
+        value = value >= GF2Device::AMPLITUDE_MAX ? 0 : value + 0.001f;
+        sink = GF2Device::expectedAmplitude(value);
+    }, statistics, errstr));
+}
+
+// Prints the results in JSON format
+static void printJSON(const Options &options, const std::vector<Result> &results)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(1);
+    stream << "{\n"
+           << "  \"benchmark\": \"gf2bench\",\n"
+           << "  \"version\": \"1.0.0\",\n"
+           << "  \"transport\": \"" << (options.hardware ? "hardware" : "simulator") << "\",\n";
+    if (options.hardware) {
+        stream << "  \"serial\": \"" << escapeJSON(options.serial) << "\",\n";
+    } else {
+        stream << "  \"latency_us\": " << options.latency << ",\n";
+    }
+    stream << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &result = results[i];
+        double throughput = result.mean > 0 ? 1e9 / result.mean : 0;
+        stream << "    {\"name\": \"" << escapeJSON(result.name) << "\""
+               << ", \"iterations\": " << result.iterations
+               << ", \"mean_ns\": " << result.mean
+               << ", \"min_ns\": " << result.min
+               << ", \"p50_ns\": " << result.p50
+               << ", \"p99_ns\": " << result.p99
+               << ", \"max_ns\": " << result.max
+               << ", \"calls_per_s\": " << throughput
+               << ", \"transfers_per_call\": " << std::setprecision(2) << result.transfers << std::setprecision(1);
+        if (result.bytes > 0) {
+            stream << ", \"bytes\": " << result.bytes
+                   << ", \"bytes_per_s\": " << throughput * result.bytes;
+        }
+        stream << ", \"errors\": " << result.errors << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n"
+           << "}\n";
+    std::cout << stream.str();
+}
+
+// Prints the usage of the program
+static void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --hardware           Benchmark the first GF2 device found, instead of the simulator\n"
+              << "  --serial SERIAL      Benchmark the GF2 device having the given serial number\n"
+              << "  --iterations N       Number of measured calls per benchmark (default: " << ITERATIONS << ")\n"
+              << "  --latency US         Latency of each simulated transfer, in microseconds (default: 0)\n";
+}
+
+int main(int argc, char **argv)
+{
+    Options options = {false, std::string(), ITERATIONS, 0};
+    int err_level = EXIT_SUCCESS;
+    for (int i = 1; i < argc && err_level == EXIT_SUCCESS; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--hardware") {
+            options.hardware = true;
+        } else if (arg == "--serial" && i + 1 < argc) {
+            options.hardware = true;
+            options.serial = argv[++i];
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            options.iterations = std::atoi(argv[++i]);
+        } else if (arg == "--latency" && i + 1 < argc) {
+            options.latency = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            printUsage(argv[0]);
+            err_level = EXIT_FAILURE;
+        }
+    }
+    if (err_level == EXIT_SUCCESS && options.iterations < 1) {
+        std::cerr << "Error: The number of iterations must be at least 1.\n";
+        err_level = EXIT_FAILURE;
+    }
+    if (err_level == EXIT_SUCCESS) {
+        std::vector<Result> results;
+        std::string errstr;
+        CP2130Sim simulator;
+        simulator.setLatency(options.latency);
+        simulator.setUSBConfig({GF2Device::VID, GF2Device::PID, 0x01, 0x00, 0x32, CP2130::PMBUSREGEN, CP2130::PRIOWRITE});
+        GF2Device device;
+        int result = options.hardware ? device.open(options.serial) : device.open(&simulator);
+        if (result == GF2Device::SUCCESS) {
+            benchmarkDevice(device, options, results, errstr);
+            device.close();  // The device must be released before it can be opened again via the CP2130 class, below
+            CP2130 cp2130;
+            result = options.hardware ? cp2130.open(GF2Device::VID, GF2Device::PID, options.serial) : cp2130.open(&simulator);
+            if (result == CP2130::SUCCESS) {
+                benchmarkCP2130(cp2130, options, results, errstr);
+                cp2130.close();
+            }
+        }
+        if (result != GF2Device::SUCCESS) {
+            std::cerr << "Error: Could not open device.\n";
+            err_level = EXIT_FAILURE;
+        } else {
+            benchmarkHelpers(options, results, errstr);
+            printJSON(options, results);
+            if (!errstr.empty()) {
+                std::cerr << errstr;
+                err_level = EXIT_FAILURE;
+            }
+        }
+    }
+    return err_level;
+}
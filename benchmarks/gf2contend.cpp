@@ -0,0 +1,356 @@
+/* GF2 contention benchmark - Version 1.0.0
+   Requires CP2130 class version 1.3.0 or later and CP2130 simulator class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cp2130sim.h"
+#include "gf2device.h"
+#include "gf2json.h"
+
+// Definitions
+const int DEVICES = 4;                // Default number of devices
+const int THREADS = 4;                // Default number of threads
+const int REQUESTS = 1000;            // Default number of requests issued by each thread, per mix
+const size_t SPI_WRITE_SIZE = 8;      // Size of the small SPI writes, matching a burst of AD9834 register writes
+const size_t SPI_READ_SIZE = 4096;    // Size of the large SPI reads
+const uint8_t EPIN = 0x82;            // Address of endpoint assuming the IN direction
+const uint8_t EPOUT = 0x01;           // Address of endpoint assuming the OUT direction
+
+// Request mix, given as the percentage of each kind of request
+struct Mix {
+    const char *name;
+    int gpio;   // GPIO reads
+    int write;  // Small SPI writes
+    int read;   // Large SPI reads (the remainder)
+};
+
+// Request mixes that are swept
+const Mix MIXES[] = {
+    {"gpio", 100, 0, 0},
+    {"spi-write", 0, 100, 0},
+    {"spi-read", 0, 0, 100},
+    {"control-loop", 60, 35, 5}  // Status polls and register writes, with an occasional readback
+};
+
+// Device under test, shared by all threads bound to it
+// The CP2130 class is not thread-safe, so that each request holds the mutex of its device
+struct Device {
+    CP2130Sim simulator;  // Only used if not benchmarking hardware (must outlive "cp2130")
+    CP2130 cp2130;
+    std::mutex mutex;
+    std::string serial;
+};
+
+// Samples gathered by a single thread
+struct Samples {
+    std::vector<double> latencies;  // Per-request latencies, in nanoseconds, including the time spent waiting for the device
+    double elapsed;                 // Time taken by the thread to issue all its requests, in nanoseconds
+    int errors;
+    std::string errstr;
+};
+
+// Per-device result of a single mix
+struct DeviceResult {
+    int threads;
+    size_t requests;
+    double throughput;  // Requests per second
+    double p50, p99;    // Latencies, in nanoseconds
+    int errors;
+};
+
+// Result of a single mix
+struct Result {
+    std::string mix;
+    size_t requests;
+    double throughput;                // Requests per second, over all devices
+    double mean, p50, p90, p99, max;  // Latencies, in nanoseconds
+    double fairness;                  // Jain's fairness index of the throughput of each device per bound thread (1 if all threads are served equally)
+    int errors;
+    std::vector<DeviceResult> devices;
+};
+
+// Options given via the command line
+struct Options {
+    bool hardware;
+    int devices;
+    int threads;
+    int requests;
+    uint32_t latency;
+    std::string mix;
+};
+
+// Returns the given percentile of a sorted vector of samples
+static double percentile(const std::vector<double> &sorted, size_t percent)
+{
+    return sorted.empty() ? 0 : sorted[std::min(sorted.size() * percent / 100, sorted.size() - 1)];
+}
+
+// Issues "requests" requests of the given mix to the given device, recording the latency of each one
+// The kind of each request is drawn from a generator seeded by the thread index, so that runs are repeatable
+static void runThread(Device &device, const Mix &mix, int requests, int index, std::atomic<int> &ready, int threads, Samples &samples)
+{
+    std::minstd_rand generator(static_cast<std::minstd_rand::result_type>(index + 1));
+    std::vector<uint8_t> data(SPI_WRITE_SIZE, 0x55);
+    samples.latencies.resize(static_cast<size_t>(requests));
+    samples.errors = 0;
+    ++ready;
+    while (ready < threads) {  // Start all threads together, so that they contend from the first request
+        std::this_thread::yield();
+    }
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < requests; ++i) {
+        int draw = static_cast<int>(generator() % 100);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(device.mutex);
+            if (draw < mix.gpio) {
+                device.cp2130.getGPIOs(samples.errors, samples.errstr);
+            } else if (draw < mix.gpio + mix.write) {
+                device.cp2130.spiWrite(data, EPOUT, samples.errors, samples.errstr);
+            } else {
+                device.cp2130.spiRead(static_cast<uint32_t>(SPI_READ_SIZE), EPIN, EPOUT, samples.errors, samples.errstr);
+            }
+        }
+        samples.latencies[i] = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    samples.elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+}
+
+// Runs the given mix, with thread "i" bound to device "i % devices.size()"
+// The throughput of each device is measured until the last of its threads finishes, so that a device that is served less often shows a lower throughput
+static Result runMix(std::vector<std::unique_ptr<Device>> &devices, const Mix &mix, const Options &options, std::string &errstr)
+{
+    std::vector<Samples> samples(static_cast<size_t>(options.threads));
+    std::vector<std::thread> threads;
+    std::atomic<int> ready(0);
+    for (int i = 0; i < options.threads; ++i) {
+        threads.push_back(std::thread(runThread, std::ref(*devices[i % devices.size()]), std::cref(mix), options.requests, i, std::ref(ready), options.threads, std::ref(samples[i])));
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    Result result;
+    result.mix = mix.name;
+    result.errors = 0;
+    std::vector<double> all;
+    double elapsed = 0;
+    double sumThroughputs = 0, sumSquares = 0;  // Of the throughput per thread of each device
+    for (size_t i = 0; i < devices.size(); ++i) {
+        DeviceResult device = {0, 0, 0, 0, 0, 0};
+        std::vector<double> latencies;
+        double deviceElapsed = 0;
+        for (size_t j = i; j < samples.size(); j += devices.size()) {
+            ++device.threads;
+            latencies.insert(latencies.end(), samples[j].latencies.begin(), samples[j].latencies.end());
+            deviceElapsed = std::max(deviceElapsed, samples[j].elapsed);
+            device.errors += samples[j].errors;
+            errstr += samples[j].errstr;
+        }
+        std::sort(latencies.begin(), latencies.end());
+        device.requests = latencies.size();
+        device.throughput = deviceElapsed > 0 ? 1e9 * device.requests / deviceElapsed : 0;
+        device.p50 = percentile(latencies, 50);
+        device.p99 = percentile(latencies, 99);
+        double share = device.throughput / device.threads;  // Devices may have different numbers of threads bound to them, unless the number of threads is a multiple of the number of devices
+        sumThroughputs += share;
+        sumSquares += share * share;
+        result.errors += device.errors;
+        elapsed = std::max(elapsed, deviceElapsed);
+        all.insert(all.end(), latencies.begin(), latencies.end());
+        result.devices.push_back(device);
+    }
+    std::sort(all.begin(), all.end());
+    double sum = 0;
+    for (double latency : all) {
+        sum += latency;
+    }
+    result.requests = all.size();
+    result.throughput = elapsed > 0 ? 1e9 * result.requests / elapsed : 0;
+    result.mean = all.empty() ? 0 : sum / all.size();
+    result.p50 = percentile(all, 50);
+    result.p90 = percentile(all, 90);
+    result.p99 = percentile(all, 99);
+    result.max = all.empty() ? 0 : all.back();
+    result.fairness = sumSquares > 0 ? sumThroughputs * sumThroughputs / (devices.size() * sumSquares) : 0;
+    return result;
+}
+
+// Prints the results in JSON format
+static void printJSON(const Options &options, const std::vector<std::unique_ptr<Device>> &devices, const std::vector<Result> &results)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(1);
+    stream << "{\n"
+           << "  \"benchmark\": \"gf2contend\",\n"
+           << "  \"version\": \"1.0.0\",\n"
+           << "  \"transport\": \"" << (options.hardware ? "hardware" : "simulator") << "\",\n";
+    if (options.hardware) {
+        stream << "  \"serials\": [";
+        for (size_t i = 0; i < devices.size(); ++i) {
+            stream << (i > 0 ? ", " : "") << "\"" << escapeJSON(devices[i]->serial) << "\"";
+        }
+        stream << "],\n";
+    } else {
+        stream << "  \"latency_us\": " << options.latency << ",\n";
+    }
+    stream << "  \"devices\": " << devices.size() << ",\n"
+           << "  \"threads\": " << options.threads << ",\n"
+           << "  \"requests_per_thread\": " << options.requests << ",\n"
+           << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &result = results[i];
+        stream << "    {\"mix\": \"" << escapeJSON(result.mix) << "\""
+               << ", \"requests\": " << result.requests
+               << ", \"requests_per_s\": " << result.throughput
+               << ", \"mean_ns\": " << result.mean
+               << ", \"p50_ns\": " << result.p50
+               << ", \"p90_ns\": " << result.p90
+               << ", \"p99_ns\": " << result.p99
+               << ", \"max_ns\": " << result.max
+               << ", \"fairness\": " << std::setprecision(3) << result.fairness << std::setprecision(1)
+               << ", \"errors\": " << result.errors
+               << ", \"devices\": [\n";
+        for (size_t j = 0; j < result.devices.size(); ++j) {
+            const DeviceResult &device = result.devices[j];
+            stream << "      {\"device\": " << j
+                   << ", \"threads\": " << device.threads
+                   << ", \"requests\": " << device.requests
+                   << ", \"requests_per_s\": " << device.throughput
+                   << ", \"p50_ns\": " << device.p50
+                   << ", \"p99_ns\": " << device.p99
+                   << ", \"errors\": " << device.errors << "}" << (j + 1 < result.devices.size() ? "," : "") << "\n";
+        }
+        stream << "    ]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    stream << "  ]\n"
+           << "}\n";
+    std::cout << stream.str();
+}
+
+// Prints the usage of the program
+static void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --hardware           Benchmark the GF2 devices found, instead of simulated ones\n"
+              << "  --devices N          Number of devices (default: " << DEVICES << ")\n"
+              << "  --threads M          Number of threads, each bound to one device (default: " << THREADS << ")\n"
+              << "  --requests N         Number of requests issued by each thread, per mix (default: " << REQUESTS << ")\n"
+              << "  --latency US         Latency of each simulated transfer, in microseconds (default: 0)\n"
+              << "  --mix NAME           Run only the given mix (gpio, spi-write, spi-read or control-loop)\n";
+}
+
+int main(int argc, char **argv)
+{
+    Options options = {false, DEVICES, THREADS, REQUESTS, 0, std::string()};
+    int err_level = EXIT_SUCCESS;
+    for (int i = 1; i < argc && err_level == EXIT_SUCCESS; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--hardware") {
+            options.hardware = true;
+        } else if (arg == "--devices" && i + 1 < argc) {
+            options.devices = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--requests" && i + 1 < argc) {
+            options.requests = std::atoi(argv[++i]);
+        } else if (arg == "--latency" && i + 1 < argc) {
+            options.latency = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--mix" && i + 1 < argc) {
+            options.mix = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            err_level = EXIT_FAILURE;
+        }
+    }
+    std::vector<const Mix *> mixes;
+    for (const Mix &mix : MIXES) {
+        if (options.mix.empty() || options.mix == mix.name) {
+            mixes.push_back(&mix);
+        }
+    }
+    if (err_level == EXIT_SUCCESS && (options.devices < 1 || options.threads < options.devices || options.requests < 1)) {
+        std::cerr << "Error: There must be at least one device, at least one thread per device and at least one request per thread.\n";
+        err_level = EXIT_FAILURE;
+    } else if (err_level == EXIT_SUCCESS && mixes.empty()) {
+        std::cerr << "Error: Unknown mix \"" << options.mix << "\".\n";
+        err_level = EXIT_FAILURE;
+    }
+    if (err_level == EXIT_SUCCESS) {
+        std::string errstr;
+        std::list<std::string> serials;
+        if (options.hardware) {
+            int errcnt = 0;
+            serials = GF2Device::listDevices(errcnt, errstr);
+        }
+        std::vector<std::unique_ptr<Device>> devices;
+        for (int i = 0; i < options.devices && err_level == EXIT_SUCCESS; ++i) {
+            std::unique_ptr<Device> device(new Device);
+            int result;
+            if (options.hardware) {
+                device->serial = serials.empty() ? std::string() : serials.front();
+                result = serials.empty() ? CP2130::ERROR_NOT_FOUND : device->cp2130.open(GF2Device::VID, GF2Device::PID, device->serial);
+                if (!serials.empty()) {
+                    serials.pop_front();
+                }
+            } else {
+                device->simulator.setLatency(options.latency);
+                result = device->cp2130.open(&device->simulator);
+            }
+            if (result != CP2130::SUCCESS) {
+                std::cerr << "Error: Could not open device " << i << ".\n";
+                err_level = EXIT_FAILURE;
+            } else {
+                int errcnt = 0;
+                device->cp2130.disableCS(0, errcnt, errstr);  // SPI transfers are done with all chip selects disabled, so that the AD9834 and the AD5310 are not affected
+                device->cp2130.disableCS(1, errcnt, errstr);
+                devices.push_back(std::move(device));
+            }
+        }
+        if (err_level == EXIT_SUCCESS) {
+            std::vector<Result> results;
+            for (const Mix *mix : mixes) {
+                results.push_back(runMix(devices, *mix, options, errstr));
+            }
+            printJSON(options, devices, results);
+            if (!errstr.empty()) {
+                std::cerr << errstr;
+                err_level = EXIT_FAILURE;
+            }
+        }
+        for (std::unique_ptr<Device> &device : devices) {
+            device->cp2130.close();
+        }
+    }
+    return err_level;
+}
@@ -0,0 +1,40 @@
+/* GF2 benchmark JSON helpers - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <iomanip>
+#include <sstream>
+#include "gf2json.h"
+
+// Escapes a string so that it can be embedded in JSON
+std::string escapeJSON(const std::string &str)
+{
+    std::ostringstream stream;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            stream << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            stream << "\\u" << std::hex << std::setfill('0') << std::setw(4) << static_cast<int>(c) << std::dec;
+        } else {
+            stream << c;
+        }
+    }
+    return stream.str();
+}
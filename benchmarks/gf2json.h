@@ -0,0 +1,29 @@
+/* GF2 benchmark JSON helpers - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2JSON_H
+#define GF2JSON_H
+
+// Includes
+#include <string>
+
+std::string escapeJSON(const std::string &str);
+
+#endif  // GF2JSON_H
@@ -1,4 +1,4 @@
-/* CP2130 class - Version 1.2.6
+/* CP2130 class - Version 1.3.0
    Copyright (c) 2021-2024 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
@@ -19,9 +19,16 @@
 
 
 // Includes
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <cstring>
+#include <fstream>
 #include <iomanip>
+#include <iterator>
 #include <sstream>
+#include <system_error>
+#include <thread>
 #include "cp2130.h"
 extern "C" {
 #include "libusb-extra.h"
@@ -35,6 +42,87 @@ const uint16_t DESC_TBLSIZE = 0x0040;          // Descriptor table size, includi
 const size_t DESC_MAXIDX = DESC_TBLSIZE - 2;   // Maximum usable index [62]
 const size_t DESC_IDXINCR = DESC_TBLSIZE - 1;  // Index increment or step between table preambles [63]
 
+// Specific to the flight recorder (added in version 1.3.0)
+inline uint64_t recorderTime()  // Returns the current time, in microseconds, as used by the flight recorder
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Specific to enumerateDevices() (added in version 1.3.0)
+const size_t ENUM_MAXTHREADS = 8;  // Maximum number of devices that are opened and queried concurrently
+
+// Specific to PROMConfig::changedFields() and updatePROMConfig() (added in version 1.3.0)
+struct PROMField {
+    size_t index;   // Field index
+    size_t size;    // Field size
+    uint16_t lock;  // Lock bit (or bits) protecting the field, if any
+};
+const PROMField PROM_FIELDS[] = {
+    {CP2130::PROMIDX_VID, CP2130::PROMSZE_VID, CP2130::LWVID},
+    {CP2130::PROMIDX_PID, CP2130::PROMSZE_PID, CP2130::LWPID},
+    {CP2130::PROMIDX_MAX_POWER, CP2130::PROMSZE_MAX_POWER, CP2130::LWMAXPOW},
+    {CP2130::PROMIDX_POWER_MODE, CP2130::PROMSZE_POWER_MODE, CP2130::LWPOWMODE},
+    {CP2130::PROMIDX_RELEASE_VERSION, CP2130::PROMSZE_RELEASE_VERSION, CP2130::LWREL},
+    {CP2130::PROMIDX_TRANSFER_PRIORITY, CP2130::PROMSZE_TRANSFER_PRIORITY, CP2130::LWTRFPRIO},
+    {CP2130::PROMIDX_MANUFACTURING_STRING_1, CP2130::PROMSZE_MANUFACTURING_STRING_1, 0x0020},  // Manufacturing string 1 corresponds to bit 5 of the lock word
+    {CP2130::PROMIDX_MANUFACTURING_STRING_2, CP2130::PROMSZE_MANUFACTURING_STRING_2, 0x0040},  // Manufacturing string 2 corresponds to bit 6 of the lock word
+    {CP2130::PROMIDX_PRODUCT_STRING_1, CP2130::PROMSZE_PRODUCT_STRING_1, 0x0100},              // Product string 1 corresponds to bit 8 of the lock word
+    {CP2130::PROMIDX_PRODUCT_STRING_2, CP2130::PROMSZE_PRODUCT_STRING_2, 0x0200},              // Product string 2 corresponds to bit 9 of the lock word
+    {CP2130::PROMIDX_SERIAL_STRING, CP2130::PROMSZE_SERIAL_STRING, CP2130::LWSER},
+    {CP2130::PROMIDX_PIN_CONFIG, CP2130::PROMSZE_PIN_CONFIG, CP2130::LWPINCFG}
+};
+
+// Private procedure used to claim the interface of a device whose handle was just obtained, or to deinitialize libusb if no handle was obtained (added as a refactor in version 1.3.0)
+int CP2130::claimDevice()
+{
+    int retval;
+    if (handle_ == nullptr) {  // If the previous operation fails to get a device handle
+        libusb_exit(context_);  // Deinitialize libusb
+        retval = ERROR_NOT_FOUND;
+    } else {  // If the device is successfully opened and a handle obtained
+        if (libusb_kernel_driver_active(handle_, 0) == 1) {  // If a kernel driver is active on the interface
+            libusb_detach_kernel_driver(handle_, 0);  // Detach the kernel driver
+            kernelWasAttached_ = true;  // Flag that the kernel driver was attached
+        } else {
+            kernelWasAttached_ = false;  // The kernel driver was not attached
+        }
+        if (libusb_claim_interface(handle_, 0) != 0) {  // Claim the interface. In case of failure
+            if (kernelWasAttached_) {  // If a kernel driver was attached to the interface before
+                libusb_attach_kernel_driver(handle_, 0);  // Reattach the kernel driver
+            }
+            libusb_close(handle_);  // Close the device
+            libusb_exit(context_);  // Deinitialize libusb
+            handle_ = nullptr;  // Required to mark the device as closed
+            retval = ERROR_BUSY;
+        } else {
+            if (disconnected_) {  // The device is being reopened after a disconnection
+                reconnects_.fetch_add(1, std::memory_order_relaxed);
+            }
+            disconnected_ = false;  // Note that this flag is never assumed to be true for a device that was never opened - See constructor for details!
+            open_ = true;
+            retval = SUCCESS;
+        }
+    }
+    return retval;
+}
+
+// Private procedure used to get any descriptor, while avoiding further control transfers once the descriptor is cached (added in version 1.3.0)
+std::u16string CP2130::getDescCached(uint8_t command, std::u16string &cache, bool &cached, int &errcnt, std::string &errstr)
+{
+    std::u16string descriptor;
+    if (cached) {
+        descriptor = cache;
+    } else {
+        int preverrcnt = errcnt;
+        descriptor = getDescGeneric(command, errcnt, errstr);
+        if (errcnt == preverrcnt) {  // Only a descriptor that was read successfully is cached
+            cache = descriptor;
+            cached = true;
+        }
+    }
+    return descriptor;
+}
+
 // Private generic procedure used to get any descriptor (added as a refactor in version 1.1.0)
 std::u16string CP2130::getDescGeneric(uint8_t command, int &errcnt, std::string &errstr)
 {
@@ -42,6 +130,7 @@ std::u16string CP2130::getDescGeneric(uint8_t command, int &errcnt, std::string
     controlTransfer(GET, command, 0x0000, 0x0000, controlBufferIn, DESC_TBLSIZE, errcnt, errstr);
     std::u16string descriptor;
     size_t length = controlBufferIn[0];
+    descriptor.reserve(length / 2);  // Avoids reallocations while appending characters (added in version 1.3.0)
     size_t end = length > DESC_MAXIDX ? DESC_MAXIDX : length;
     for (size_t i = 2; i < end; i += 2) {  // Process first 30 characters (bytes 2-61 of the array)
         if (controlBufferIn[i] != 0 || controlBufferIn[i + 1] != 0) {  // Filter out null characters
@@ -65,6 +154,46 @@ std::u16string CP2130::getDescGeneric(uint8_t command, int &errcnt, std::string
     return descriptor;
 }
 
+// Private procedure used to store an operation in the flight recorder, overwriting the oldest one (added in version 1.3.0)
+// The recorder is lock-free: each slot is guarded by its own state, which readers check before and after copying the record
+void CP2130::recordOperation(OperationRecord &record)
+{
+    uint64_t sequence = recorderHead_.fetch_add(1, std::memory_order_relaxed);
+    RecorderSlot &slot = recorder_[sequence % RECORDER_SIZE];
+    record.sequence = sequence;
+    slot.state.store(2 * sequence, std::memory_order_relaxed);  // An even state marks the slot as being written
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.record = record;
+    slot.state.store(2 * sequence + 1, std::memory_order_release);
+}
+
+// Private procedure used to update the statistics after a transfer (added in version 1.3.0)
+// Only atomic increments are done here, so that the cost to the transfer path is negligible
+void CP2130::countTransfer(const OperationRecord &record, bool in, int bytes, bool failed)
+{
+    (record.bulk ? bulkTransfers_ : controlTransfers_).fetch_add(1, std::memory_order_relaxed);
+    if (bytes > 0) {
+        (in ? bytesIn_ : bytesOut_).fetch_add(static_cast<uint64_t>(bytes), std::memory_order_relaxed);
+    }
+    if (failed) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+    latencySum_.fetch_add(record.duration, std::memory_order_relaxed);
+    size_t bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && record.duration > latencyBound(bucket)) {
+        ++bucket;
+    }
+    latencyBuckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+// Private procedure used to discard any cached descriptors, so that these are read again from the device (added in version 1.3.0)
+void CP2130::invalidateDescCache()
+{
+    manufacturerCached_ = false;
+    productCached_ = false;
+    serialCached_ = false;
+}
+
 // Private generic procedure used to write any descriptor (added as a refactor in version 1.1.0)
 void CP2130::writeDescGeneric(const std::u16string &descriptor, uint8_t command, int &errcnt, std::string &errstr)
 {
@@ -88,6 +217,18 @@ void CP2130::writeDescGeneric(const std::u16string &descriptor, uint8_t command,
     }
 }
 
+// "Equal to" operator for DeviceInfo
+bool CP2130::DeviceInfo::operator ==(const CP2130::DeviceInfo &other) const
+{
+    return bus == other.bus && address == other.address && ports == other.ports && serial == other.serial && manufacturer == other.manufacturer && product == other.product;
+}
+
+// "Not equal to" operator for DeviceInfo
+bool CP2130::DeviceInfo::operator !=(const CP2130::DeviceInfo &other) const
+{
+    return !(operator ==(other));
+}
+
 // "Equal to" operator for EventCounter
 bool CP2130::EventCounter::operator ==(const CP2130::EventCounter &other) const
 {
@@ -100,6 +241,18 @@ bool CP2130::EventCounter::operator !=(const CP2130::EventCounter &other) const
     return !(operator ==(other));
 }
 
+// "Equal to" operator for OperationRecord
+bool CP2130::OperationRecord::operator ==(const CP2130::OperationRecord &other) const
+{
+    return sequence == other.sequence && timestamp == other.timestamp && duration == other.duration && bulk == other.bulk && requestType == other.requestType && request == other.request && value == other.value && index == other.index && length == other.length && result == other.result;
+}
+
+// "Not equal to" operator for OperationRecord
+bool CP2130::OperationRecord::operator !=(const CP2130::OperationRecord &other) const
+{
+    return !(operator ==(other));
+}
+
 // "Equal to" operator for PinConfig
 bool CP2130::PinConfig::operator ==(const CP2130::PinConfig &other) const
 {
@@ -136,6 +289,48 @@ bool CP2130::PROMConfig::operator !=(const CP2130::PROMConfig &other) const
     return !(operator ==(other));
 }
 
+// Returns a bitmap, in the same format as the lock word, of the lockable fields that differ between two PROMConfig structures (added in version 1.3.0)
+uint16_t CP2130::PROMConfig::changedFields(const CP2130::PROMConfig &other) const
+{
+    uint16_t changed = 0x0000;
+    for (const PROMField &field : PROM_FIELDS) {
+        for (size_t i = field.index; i < field.index + field.size; ++i) {
+            if (operator [](i) != other[i]) {
+                changed = static_cast<uint16_t>(changed | field.lock);
+                break;
+            }
+        }
+    }
+    return changed;
+}
+
+// Private generic procedure used to get any descriptor stored in a PROMConfig structure, without accessing the device (added in version 1.3.0)
+// Note that, within the OTP ROM, a descriptor split into two fields is stored contiguously, so "size" should be the combined size of both fields
+std::u16string CP2130::PROMConfig::getDescGeneric(size_t index, size_t size) const
+{
+    std::u16string descriptor;
+    size_t length = operator [](index);
+    size_t end = index + (length > size ? size : length);
+    descriptor.reserve((end - index) / 2);  // Avoids reallocations while appending, since the final length is known in advance
+    for (size_t i = index + 2; i + 1 < end; i += 2) {
+        if (operator [](i) != 0 || operator [](i + 1) != 0) {  // Filter out null characters
+            descriptor += static_cast<char16_t>(operator [](i + 1) << 8 | operator [](i));  // UTF-16LE conversion as per the USB 2.0 specification
+        }
+    }
+    return descriptor;
+}
+
+// Private generic procedure used to set any descriptor stored in a PROMConfig structure, in place (added in version 1.3.0)
+void CP2130::PROMConfig::setDescGeneric(const std::u16string &descriptor, size_t index, size_t size)
+{
+    size_t length = 2 * descriptor.size() + 2;
+    operator [](index) = static_cast<uint8_t>(length);  // USB string descriptor length
+    operator [](index + 1) = 0x03;                      // USB string descriptor constant
+    for (size_t i = 2; i < size; ++i) {
+        operator [](index + i) = i < length ? static_cast<uint8_t>(descriptor[(i - 2) / 2] >> (i % 2 == 0 ? 0 : 8)) : 0x00;  // The remaining bytes are filled with zeros
+    }
+}
+
 // Subscript operator for accessing PROMConfig as a single 512-byte block
 uint8_t &CP2130::PROMConfig::operator [](size_t index)
 {
@@ -148,6 +343,268 @@ const uint8_t &CP2130::PROMConfig::operator [](size_t index) const  // For corre
     return blocks[index / PROM_BLOCK_SIZE][index % PROM_BLOCK_SIZE];
 }
 
+// Returns the lock word stored in PROMConfig (added in version 1.3.0)
+uint16_t CP2130::PROMConfig::getLockWord() const
+{
+    return static_cast<uint16_t>(operator [](PROMIDX_LOCK_BYTE + 1) << 8 | operator [](PROMIDX_LOCK_BYTE));  // Little-endian conversion
+}
+
+// Returns the major release version stored in PROMConfig (added in version 1.3.0)
+uint8_t CP2130::PROMConfig::getMajorRelease() const
+{
+    return operator [](PROMIDX_RELEASE_VERSION);
+}
+
+// Returns the manufacturer descriptor stored in PROMConfig (added in version 1.3.0)
+std::u16string CP2130::PROMConfig::getManufacturerDesc() const
+{
+    return getDescGeneric(PROMIDX_MANUFACTURING_STRING_1, PROMSZE_MANUFACTURING_STRING_1 + PROMSZE_MANUFACTURING_STRING_2);
+}
+
+// Returns the maximum consumption current stored in PROMConfig (raw value in 2mA units - added in version 1.3.0)
+uint8_t CP2130::PROMConfig::getMaxPower() const
+{
+    return operator [](PROMIDX_MAX_POWER);
+}
+
+// Returns the minor release version stored in PROMConfig (added in version 1.3.0)
+uint8_t CP2130::PROMConfig::getMinorRelease() const
+{
+    return operator [](PROMIDX_RELEASE_VERSION + 1);
+}
+
+// Returns the product ID stored in PROMConfig (added in version 1.3.0)
+uint16_t CP2130::PROMConfig::getPID() const
+{
+    return static_cast<uint16_t>(operator [](PROMIDX_PID + 1) << 8 | operator [](PROMIDX_PID));  // Little-endian conversion
+}
+
+// Returns the pin configuration stored in PROMConfig (added in version 1.3.0)
+CP2130::PinConfig CP2130::PROMConfig::getPinConfig() const
+{
+    const size_t base = PROMIDX_PIN_CONFIG;  // The pin configuration is stored in the same format as the one used by getPinConfig()
+    PinConfig config;
+    config.gpio0 = operator [](base);
+    config.gpio1 = operator [](base + 1);
+    config.gpio2 = operator [](base + 2);
+    config.gpio3 = operator [](base + 3);
+    config.gpio4 = operator [](base + 4);
+    config.gpio5 = operator [](base + 5);
+    config.gpio6 = operator [](base + 6);
+    config.gpio7 = operator [](base + 7);
+    config.gpio8 = operator [](base + 8);
+    config.gpio9 = operator [](base + 9);
+    config.gpio10 = operator [](base + 10);
+    config.sspndlvl = static_cast<uint16_t>(operator [](base + 11) << 8 | operator [](base + 12));   // Big-endian conversion
+    config.sspndmode = static_cast<uint16_t>(operator [](base + 13) << 8 | operator [](base + 14));  // Big-endian conversion
+    config.wkupmask = static_cast<uint16_t>(operator [](base + 15) << 8 | operator [](base + 16));   // Big-endian conversion
+    config.wkupmatch = static_cast<uint16_t>(operator [](base + 17) << 8 | operator [](base + 18));  // Big-endian conversion
+    config.divider = operator [](base + 19);
+    return config;
+}
+
+// Returns the power mode stored in PROMConfig (added in version 1.3.0)
+uint8_t CP2130::PROMConfig::getPowerMode() const
+{
+    return operator [](PROMIDX_POWER_MODE);
+}
+
+// Returns the product descriptor stored in PROMConfig (added in version 1.3.0)
+std::u16string CP2130::PROMConfig::getProductDesc() const
+{
+    return getDescGeneric(PROMIDX_PRODUCT_STRING_1, PROMSZE_PRODUCT_STRING_1 + PROMSZE_PRODUCT_STRING_2);
+}
+
+// Returns the serial descriptor stored in PROMConfig (added in version 1.3.0)
+std::u16string CP2130::PROMConfig::getSerialDesc() const
+{
+    return getDescGeneric(PROMIDX_SERIAL_STRING, PROMSZE_SERIAL_STRING);
+}
+
+// Returns the transfer priority stored in PROMConfig (added in version 1.3.0)
+uint8_t CP2130::PROMConfig::getTransferPriority() const
+{
+    return operator [](PROMIDX_TRANSFER_PRIORITY);
+}
+
+// Returns the vendor ID stored in PROMConfig (added in version 1.3.0)
+uint16_t CP2130::PROMConfig::getVID() const
+{
+    return static_cast<uint16_t>(operator [](PROMIDX_VID + 1) << 8 | operator [](PROMIDX_VID));  // Little-endian conversion
+}
+
+// Sets the lock word in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setLockWord(uint16_t word)
+{
+    operator [](PROMIDX_LOCK_BYTE) = static_cast<uint8_t>(word);
+    operator [](PROMIDX_LOCK_BYTE + 1) = static_cast<uint8_t>(word >> 8);
+}
+
+// Sets the major release version in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setMajorRelease(uint8_t majrel)
+{
+    operator [](PROMIDX_RELEASE_VERSION) = majrel;
+}
+
+// Sets the manufacturer descriptor in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setManufacturerDesc(const std::u16string &manufacturer, int &errcnt, std::string &errstr)
+{
+    if (manufacturer.size() > DESCMXL_MANUFACTURER) {
+        ++errcnt;
+        errstr += "In setManufacturerDesc(): manufacturer descriptor string cannot be longer than 62 characters.\n";  // Program logic error
+    } else {
+        setDescGeneric(manufacturer, PROMIDX_MANUFACTURING_STRING_1, PROMSZE_MANUFACTURING_STRING_1 + PROMSZE_MANUFACTURING_STRING_2);
+    }
+}
+
+// Sets the maximum consumption current in PROMConfig (raw value in 2mA units - added in version 1.3.0)
+void CP2130::PROMConfig::setMaxPower(uint8_t maxpow)
+{
+    operator [](PROMIDX_MAX_POWER) = maxpow;
+}
+
+// Sets the minor release version in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setMinorRelease(uint8_t minrel)
+{
+    operator [](PROMIDX_RELEASE_VERSION + 1) = minrel;
+}
+
+// Sets the product ID in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setPID(uint16_t pid)
+{
+    operator [](PROMIDX_PID) = static_cast<uint8_t>(pid);
+    operator [](PROMIDX_PID + 1) = static_cast<uint8_t>(pid >> 8);
+}
+
+// Sets the pin configuration in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setPinConfig(const PinConfig &config)
+{
+    const size_t base = PROMIDX_PIN_CONFIG;  // Same format as the one used by writePinConfig()
+    operator [](base) = config.gpio0;
+    operator [](base + 1) = config.gpio1;
+    operator [](base + 2) = config.gpio2;
+    operator [](base + 3) = config.gpio3;
+    operator [](base + 4) = config.gpio4;
+    operator [](base + 5) = config.gpio5;
+    operator [](base + 6) = config.gpio6;
+    operator [](base + 7) = config.gpio7;
+    operator [](base + 8) = config.gpio8;
+    operator [](base + 9) = config.gpio9;
+    operator [](base + 10) = config.gpio10;
+    operator [](base + 11) = static_cast<uint8_t>(0x7f & config.sspndlvl >> 8);
+    operator [](base + 12) = static_cast<uint8_t>(config.sspndlvl);
+    operator [](base + 13) = static_cast<uint8_t>(config.sspndmode >> 8);
+    operator [](base + 14) = static_cast<uint8_t>(config.sspndmode);
+    operator [](base + 15) = static_cast<uint8_t>(0x7f & config.wkupmask >> 8);
+    operator [](base + 16) = static_cast<uint8_t>(config.wkupmask);
+    operator [](base + 17) = static_cast<uint8_t>(0x7f & config.wkupmatch >> 8);
+    operator [](base + 18) = static_cast<uint8_t>(config.wkupmatch);
+    operator [](base + 19) = config.divider;
+}
+
+// Sets the power mode in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setPowerMode(uint8_t powmode)
+{
+    operator [](PROMIDX_POWER_MODE) = powmode;
+}
+
+// Sets the product descriptor in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setProductDesc(const std::u16string &product, int &errcnt, std::string &errstr)
+{
+    if (product.size() > DESCMXL_PRODUCT) {
+        ++errcnt;
+        errstr += "In setProductDesc(): product descriptor string cannot be longer than 62 characters.\n";  // Program logic error
+    } else {
+        setDescGeneric(product, PROMIDX_PRODUCT_STRING_1, PROMSZE_PRODUCT_STRING_1 + PROMSZE_PRODUCT_STRING_2);
+    }
+}
+
+// Sets the serial descriptor in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setSerialDesc(const std::u16string &serial, int &errcnt, std::string &errstr)
+{
+    if (serial.size() > DESCMXL_SERIAL) {
+        ++errcnt;
+        errstr += "In setSerialDesc(): serial descriptor string cannot be longer than 30 characters.\n";  // Program logic error
+    } else {
+        setDescGeneric(serial, PROMIDX_SERIAL_STRING, PROMSZE_SERIAL_STRING);
+    }
+}
+
+// Sets the transfer priority in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setTransferPriority(uint8_t trfprio)
+{
+    operator [](PROMIDX_TRANSFER_PRIORITY) = trfprio;
+}
+
+// Sets the vendor ID in PROMConfig (added in version 1.3.0)
+void CP2130::PROMConfig::setVID(uint16_t vid)
+{
+    operator [](PROMIDX_VID) = static_cast<uint8_t>(vid);
+    operator [](PROMIDX_VID + 1) = static_cast<uint8_t>(vid >> 8);
+}
+
+// Checks the content of PROMConfig against the rules that apply to the CP2130 OTP ROM, reporting each violation found (added in version 1.3.0)
+// This allows OTP ROM images to be validated without a device attached
+void CP2130::PROMConfig::validate(int &errcnt, std::string &errstr) const
+{
+    std::ostringstream stream;
+    int preverrcnt = errcnt;
+    if (getMaxPower() > 0xfa) {  // The maximum consumption current cannot exceed 500mA, as per the USB 2.0 specification
+        ++errcnt;
+        stream << "In validate(): Maximum power value must be between 0 and 250 (found " << static_cast<int>(getMaxPower()) << ")." << std::endl;
+    }
+    if (getPowerMode() > PMSELFREGEN) {
+        ++errcnt;
+        stream << "In validate(): Invalid power mode (found " << static_cast<int>(getPowerMode()) << ")." << std::endl;
+    }
+    if (getTransferPriority() > PRIOWRITE) {
+        ++errcnt;
+        stream << "In validate(): Invalid transfer priority (found " << static_cast<int>(getTransferPriority()) << ")." << std::endl;
+    }
+    const struct {
+        const char *name;  // Descriptor name, used for error reporting
+        size_t index;      // Descriptor index
+        size_t maxlen;     // Maximum descriptor length, in characters
+    } descs[] = {
+        {"Manufacturer", PROMIDX_MANUFACTURING_STRING_1, DESCMXL_MANUFACTURER},
+        {"Product", PROMIDX_PRODUCT_STRING_1, DESCMXL_PRODUCT},
+        {"Serial", PROMIDX_SERIAL_STRING, DESCMXL_SERIAL}
+    };
+    for (const auto &desc : descs) {
+        size_t length = operator [](desc.index);
+        if (length < 2 || length % 2 != 0 || length > 2 * desc.maxlen + 2) {
+            ++errcnt;
+            stream << "In validate(): " << desc.name << " descriptor has an invalid length (found " << length << " bytes)." << std::endl;
+        }
+        if (operator [](desc.index + 1) != 0x03) {
+            ++errcnt;
+            stream << "In validate(): " << desc.name << " descriptor is not a USB string descriptor." << std::endl;
+        }
+    }
+    const uint8_t maxmodes[] = {  // Highest pin mode allowed for each GPIO pin
+        PCCS, PCCS, PCCS, PCRTR, PCEVTCNTRPP, PCCLKOUT, PCCS, PCCS, PCSPIACT, PCSSPND, PCNSSPND
+    };
+    for (size_t i = 0; i < sizeof(maxmodes); ++i) {
+        uint8_t mode = operator [](PROMIDX_PIN_CONFIG + i);
+        if (mode > maxmodes[i]) {
+            ++errcnt;
+            stream << "In validate(): Invalid pin mode for GPIO." << i << " (found " << static_cast<int>(mode) << ")." << std::endl;
+        }
+    }
+    uint16_t lockWord = getLockWord();
+    if ((LWMANUF & lockWord) != 0x0000 && (LWMANUF & lockWord) != LWMANUF) {  // Both manufacturer descriptor lock bits should be set or cleared together, since the descriptor spans both fields
+        ++errcnt;
+        stream << "In validate(): Manufacturer descriptor is only partially locked." << std::endl;
+    }
+    if ((LWPROD & lockWord) != 0x0000 && (LWPROD & lockWord) != LWPROD) {  // The same applies to the product descriptor
+        ++errcnt;
+        stream << "In validate(): Product descriptor is only partially locked." << std::endl;
+    }
+    if (errcnt != preverrcnt) {
+        errstr += stream.str();
+    }
+}
+
 // "Equal to" operator for SiliconVersion
 bool CP2130::SiliconVersion::operator ==(const CP2130::SiliconVersion &other) const
 {
@@ -184,6 +641,22 @@ bool CP2130::SPIMode::operator !=(const CP2130::SPIMode &other) const
     return !(operator ==(other));
 }
 
+// "Equal to" operator for Statistics
+bool CP2130::Statistics::operator ==(const CP2130::Statistics &other) const
+{
+    bool equal = controlTransfers == other.controlTransfers && bulkTransfers == other.bulkTransfers && bytesIn == other.bytesIn && bytesOut == other.bytesOut && errors == other.errors && reconnects == other.reconnects && latencySum == other.latencySum;
+    for (size_t i = 0; equal && i < LATENCY_BUCKETS; ++i) {
+        equal = latencyBuckets[i] == other.latencyBuckets[i];
+    }
+    return equal;
+}
+
+// "Not equal to" operator for Statistics
+bool CP2130::Statistics::operator !=(const CP2130::Statistics &other) const
+{
+    return !(operator ==(other));
+}
+
 // "Equal to" operator for USBConfig
 bool CP2130::USBConfig::operator ==(const CP2130::USBConfig &other) const
 {
@@ -196,12 +669,39 @@ bool CP2130::USBConfig::operator !=(const CP2130::USBConfig &other) const
     return !(operator ==(other));
 }
 
+// Since the destructor of an interface must be virtual, it is defined here, even though it does nothing (added in version 1.3.0)
+CP2130Transport::~CP2130Transport()
+{
+}
+
 CP2130::CP2130() :
     context_(nullptr),
     handle_(nullptr),
+    transport_(nullptr),
+    open_(false),
     disconnected_(false),
-    kernelWasAttached_(false)
-{
+    kernelWasAttached_(false),
+    manufacturerCached_(false),
+    productCached_(false),
+    serialCached_(false),
+    manufacturerDesc_(),
+    productDesc_(),
+    serialDesc_(),
+    recorderHead_(0),
+    controlTransfers_(0),
+    bulkTransfers_(0),
+    bytesIn_(0),
+    bytesOut_(0),
+    errors_(0),
+    reconnects_(0),
+    latencySum_(0)
+{
+    for (RecorderSlot &slot : recorder_) {
+        slot.state.store(0, std::memory_order_relaxed);  // All slots start empty
+    }
+    for (std::atomic<uint64_t> &bucket : latencyBuckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
 }
 
 CP2130::~CP2130()
@@ -215,10 +715,76 @@ bool CP2130::disconnected() const
     return disconnected_;  // Returns true if the device has been disconnected, or false otherwise
 }
 
+// Returns the operations kept by the flight recorder, in a human readable format (added in version 1.3.0)
+std::string CP2130::dumpRecentOperations() const
+{
+    std::ostringstream stream;
+    for (const OperationRecord &record : getRecentOperations()) {
+        stream << "#" << record.sequence << " at " << record.timestamp << "us: ";
+        if (record.bulk) {
+            stream << "bulk transfer (0x"
+                   << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(record.request)
+                   << std::dec << ", " << record.length << " bytes)";
+        } else {
+            stream << "control transfer (0x"
+                   << std::hex << std::setfill ('0') << std::setw(2) << static_cast<int>(record.requestType)
+                   << ", 0x"
+                   << std::setw(2) << static_cast<int>(record.request)
+                   << ", 0x"
+                   << std::setw(4) << record.value
+                   << ", 0x"
+                   << std::setw(4) << record.index
+                   << std::dec << ", " << record.length << " bytes)";
+        }
+        stream << " returned " << record.result << " after " << record.duration << "us" << std::endl;
+    }
+    return stream.str();
+}
+
+// Returns the operations kept by the flight recorder, from the oldest to the most recent (added in version 1.3.0)
+// This function can be called from any thread, even while transfers are taking place, and records being overwritten at the time are skipped
+std::vector<CP2130::OperationRecord> CP2130::getRecentOperations() const
+{
+    std::vector<OperationRecord> records;
+    records.reserve(RECORDER_SIZE);
+    uint64_t head = recorderHead_.load(std::memory_order_acquire);
+    uint64_t first = head > RECORDER_SIZE ? head - RECORDER_SIZE : 0;
+    for (uint64_t sequence = first; sequence < head; ++sequence) {
+        const RecorderSlot &slot = recorder_[sequence % RECORDER_SIZE];
+        uint64_t state = slot.state.load(std::memory_order_acquire);
+        if (state == 2 * sequence + 1) {  // Only complete records having the expected sequence number are copied
+            OperationRecord record = slot.record;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.state.load(std::memory_order_relaxed) == state) {  // Discard the copy if the slot was overwritten meanwhile
+                records.push_back(record);
+            }
+        }
+    }
+    return records;
+}
+
+// Returns the transfer statistics gathered since the creation of the object (added in version 1.3.0)
+// As with getRecentOperations(), this function can be called from any thread
+CP2130::Statistics CP2130::getStatistics() const
+{
+    Statistics statistics;
+    statistics.controlTransfers = controlTransfers_.load(std::memory_order_relaxed);
+    statistics.bulkTransfers = bulkTransfers_.load(std::memory_order_relaxed);
+    statistics.bytesIn = bytesIn_.load(std::memory_order_relaxed);
+    statistics.bytesOut = bytesOut_.load(std::memory_order_relaxed);
+    statistics.errors = errors_.load(std::memory_order_relaxed);
+    statistics.reconnects = reconnects_.load(std::memory_order_relaxed);
+    statistics.latencySum = latencySum_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < LATENCY_BUCKETS; ++i) {
+        statistics.latencyBuckets[i] = latencyBuckets_[i].load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
 // Checks if the device is open
 bool CP2130::isOpen() const
 {
-    return handle_ != nullptr;  // Returns true if the device is open, or false otherwise
+    return open_;  // Returns true if the device is open, or false otherwise
 }
 
 // Safe bulk transfer
@@ -228,8 +794,14 @@ void CP2130::bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length,
         ++errcnt;
         errstr += "In bulkTransfer(): device is not open.\n";  // Program logic error
     } else {
-        int result = libusb_bulk_transfer(handle_, endpointAddr, data, length, transferred, TR_TIMEOUT);
-        if (result != 0 || (transferred != nullptr && *transferred != length)) {  // The number of transferred bytes is also verified, as long as a valid (non-null) pointer is passed via "transferred"
+        OperationRecord record = {0, recorderTime(), 0, true, 0x00, endpointAddr, 0x0000, 0x0000, length, 0};
+        int result = transport_ != nullptr ? transport_->bulkTransfer(endpointAddr, data, length, transferred) : libusb_bulk_transfer(handle_, endpointAddr, data, length, transferred, TR_TIMEOUT);
+        record.duration = static_cast<uint32_t>(recorderTime() - record.timestamp);
+        record.result = result;
+        recordOperation(record);
+        bool failed = result != 0 || (transferred != nullptr && *transferred != length);
+        countTransfer(record, endpointAddr >= 0x80, result != 0 ? 0 : (transferred != nullptr ? *transferred : length), failed);
+        if (failed) {  // The number of transferred bytes is also verified, as long as a valid (non-null) pointer is passed via "transferred"
             ++errcnt;
             std::ostringstream stream;
             if (endpointAddr < 0x80) {
@@ -256,7 +828,12 @@ void CP2130::bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length,
 // Closes the device safely, if open
 void CP2130::close()
 {
-    if (isOpen()) {  // This condition avoids a segmentation fault if the calling algorithm tries, for some reason, to close the same device twice (e.g., if the device is already closed when the destructor is called)
+    if (transport_ != nullptr) {  // A device served by an alternative transport only needs to be detached (added in version 1.3.0)
+        open_ = false;
+        transport_ = nullptr;
+        invalidateDescCache();
+    } else if (isOpen()) {  // This condition avoids a segmentation fault if the calling algorithm tries, for some reason, to close the same device twice (e.g., if the device is already closed when the destructor is called)
+        open_ = false;
         libusb_release_interface(handle_, 0);  // Release the interface
         if (kernelWasAttached_) {  // If a kernel driver was attached to the interface before
             libusb_attach_kernel_driver(handle_, 0);  // Reattach the kernel driver
@@ -264,6 +841,7 @@ void CP2130::close()
         libusb_close(handle_);  // Close the device
         libusb_exit(context_);  // Deinitialize libusb
         handle_ = nullptr;  // Required to mark the device as closed
+        invalidateDescCache();  // The cached descriptors belong to the device that was just closed
     }
 }
 
@@ -324,7 +902,12 @@ void CP2130::controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t w
         ++errcnt;
         errstr += "In controlTransfer(): device is not open.\n";  // Program logic error
     } else {
-        int result = libusb_control_transfer(handle_, bmRequestType, bRequest, wValue, wIndex, data, wLength, TR_TIMEOUT);
+        OperationRecord record = {0, recorderTime(), 0, false, bmRequestType, bRequest, wValue, wIndex, wLength, 0};
+        int result = transport_ != nullptr ? transport_->controlTransfer(bmRequestType, bRequest, wValue, wIndex, data, wLength) : libusb_control_transfer(handle_, bmRequestType, bRequest, wValue, wIndex, data, wLength, TR_TIMEOUT);
+        record.duration = static_cast<uint32_t>(recorderTime() - record.timestamp);
+        record.result = result;
+        recordOperation(record);
+        countTransfer(record, bmRequestType >= 0x80, result, result != wLength);
         if (result != wLength) {
             ++errcnt;
             std::ostringstream stream;
@@ -530,7 +1113,7 @@ uint16_t CP2130::getLockWord(int &errcnt, std::string &errstr)
 // Gets the manufacturer descriptor from the CP2130 OTP ROM
 std::u16string CP2130::getManufacturerDesc(int &errcnt, std::string &errstr)
 {
-    return getDescGeneric(GET_MANUFACTURING_STRING_1, errcnt, errstr);
+    return getDescCached(GET_MANUFACTURING_STRING_1, manufacturerDesc_, manufacturerCached_, errcnt, errstr);  // Cached since version 1.3.0
 }
 
 // Gets the pin configuration from the CP2130 OTP ROM
@@ -561,7 +1144,7 @@ CP2130::PinConfig CP2130::getPinConfig(int &errcnt, std::string &errstr)
 // Gets the product descriptor from the CP2130 OTP ROM
 std::u16string CP2130::getProductDesc(int &errcnt, std::string &errstr)
 {
-    return getDescGeneric(GET_PRODUCT_STRING_1, errcnt, errstr);
+    return getDescCached(GET_PRODUCT_STRING_1, productDesc_, productCached_, errcnt, errstr);  // Cached since version 1.3.0
 }
 
 // Gets the entire CP2130 OTP ROM content as a structure of eight 64-byte blocks
@@ -581,7 +1164,7 @@ CP2130::PROMConfig CP2130::getPROMConfig(int &errcnt, std::string &errstr)
 // Gets the serial descriptor from the CP2130 OTP ROM
 std::u16string CP2130::getSerialDesc(int &errcnt, std::string &errstr)
 {
-    return getDescGeneric(GET_SERIAL_STRING, errcnt, errstr);
+    return getDescCached(GET_SERIAL_STRING, serialDesc_, serialCached_, errcnt, errstr);  // Cached since version 1.3.0
 }
 
 // Returns the CP2130 silicon, read-only version
@@ -702,37 +1285,77 @@ int CP2130::open(uint16_t vid, uint16_t pid, const std::string &serial)
             handle_ = libusb_open_device_with_vid_pid_serial(context_, vid, pid, reinterpret_cast<unsigned char *>(serialcstr));
             delete[] serialcstr;
         }
-        if (handle_ == nullptr) {  // If the previous operation fails to get a device handle
-            libusb_exit(context_);  // Deinitialize libusb
-            retval = ERROR_NOT_FOUND;
-        } else {  // If the device is successfully opened and a handle obtained
-            if (libusb_kernel_driver_active(handle_, 0) == 1) {  // If a kernel driver is active on the interface
-                libusb_detach_kernel_driver(handle_, 0);  // Detach the kernel driver
-                kernelWasAttached_ = true;  // Flag that the kernel driver was attached
-            } else {
-                kernelWasAttached_ = false;  // The kernel driver was not attached
-            }
-            if (libusb_claim_interface(handle_, 0) != 0) {  // Claim the interface. In case of failure
-                if (kernelWasAttached_) {  // If a kernel driver was attached to the interface before
-                    libusb_attach_kernel_driver(handle_, 0);  // Reattach the kernel driver
-                }
-                libusb_close(handle_);  // Close the device
-                libusb_exit(context_);  // Deinitialize libusb
-                handle_ = nullptr;  // Required to mark the device as closed
-                retval = ERROR_BUSY;
-            } else {
-                disconnected_ = false;  // Note that this flag is never assumed to be true for a device that was never opened - See constructor for details!
-                retval = SUCCESS;
+        retval = claimDevice();  // Refactored in version 1.3.0
+    }
+    return retval;
+}
+
+// Opens the device having the given VID and PID, located as described by a DeviceInfo structure obtained via enumerateDevices(), and assigns its handle (added in version 1.3.0)
+// Since the device is located by its bus number and address, no other device is opened in the process, and it is only kept open if its serial number matches
+int CP2130::open(uint16_t vid, uint16_t pid, const DeviceInfo &device)
+{
+    int retval;
+    if (isOpen()) {  // Same as above
+        retval = SUCCESS;
+    } else if (libusb_init(&context_) != 0) {  // Initialize libusb. In case of failure
+        retval = ERROR_INIT;
+    } else {  // If libusb is initialized
+        handle_ = libusb_open_device_with_vid_pid_bus_address(context_, vid, pid, device.bus, device.address);
+        retval = claimDevice();
+        if (retval == SUCCESS) {  // Since the address may have been reassigned to another device after the enumeration, the serial number is verified as well
+            libusb_device_descriptor desc;
+            unsigned char str_desc[256];
+            if (libusb_get_device_descriptor(libusb_get_device(handle_), &desc) != 0 || libusb_get_string_descriptor_ascii(handle_, desc.iSerialNumber, str_desc, static_cast<int>(sizeof(str_desc))) < 0 || device.serial != reinterpret_cast<char *>(str_desc)) {
+                close();
+                retval = ERROR_NOT_FOUND;
             }
         }
     }
     return retval;
 }
 
+// Opens the device having the given VID and PID, located at the given bus number and port path, and assigns its handle (added in version 1.3.0)
+// Unlike the address, the port path of a device does not change when it is reconnected to the same port, so it is suitable for addressing devices wired in a fixed topology
+int CP2130::open(uint16_t vid, uint16_t pid, uint8_t bus, const std::vector<uint8_t> &ports)
+{
+    int retval;
+    if (isOpen()) {  // Same as above
+        retval = SUCCESS;
+    } else if (libusb_init(&context_) != 0) {  // Initialize libusb. In case of failure
+        retval = ERROR_INIT;
+    } else {  // If libusb is initialized
+        handle_ = libusb_open_device_with_vid_pid_path(context_, vid, pid, bus, ports.data(), static_cast<int>(ports.size()));
+        retval = claimDevice();
+    }
+    return retval;
+}
+
+// Attaches an alternative transport, such as a CP2130Sim simulated device, so that all subsequent transfers are served by it instead of libusb (added in version 1.3.0)
+// This allows benchmarking and testing without hardware, and the transport must remain valid until the device is closed
+int CP2130::open(CP2130Transport *transport)
+{
+    int retval;
+    if (isOpen()) {  // Same as above
+        retval = SUCCESS;
+    } else if (transport == nullptr) {
+        retval = ERROR_NOT_FOUND;
+    } else {
+        transport_ = transport;
+        if (disconnected_) {  // As in claimDevice()
+            reconnects_.fetch_add(1, std::memory_order_relaxed);
+        }
+        disconnected_ = false;
+        open_ = true;
+        retval = SUCCESS;
+    }
+    return retval;
+}
+
 // Issues a reset to the CP2130
 void CP2130::reset(int &errcnt, std::string &errstr)
 {
     controlTransfer(SET, RESET_DEVICE, 0x0000, 0x0000, nullptr, RESET_DEVICE_WLEN, errcnt, errstr);
+    invalidateDescCache();
 }
 
 // Enables the chip select of the target channel, disabling any others
@@ -1000,6 +1623,7 @@ void CP2130::writeManufacturerDesc(const std::u16string &manufacturer, int &errc
         errstr += "In writeManufacturerDesc(): manufacturer descriptor string cannot be longer than 62 characters.\n";  // Program logic error
     } else {
         writeDescGeneric(manufacturer, SET_MANUFACTURING_STRING_1, errcnt, errstr);  // Refactored in version 1.1.0
+        manufacturerCached_ = false;
     }
 }
 
@@ -1035,6 +1659,7 @@ void CP2130::writeProductDesc(const std::u16string &product, int &errcnt, std::s
         errstr += "In writeProductDesc(): product descriptor string cannot be longer than 62 characters.\n";  // Program logic error
     } else {
         writeDescGeneric(product, SET_PRODUCT_STRING_1, errcnt, errstr);  // Refactored in version 1.1.0
+        productCached_ = false;
     }
 }
 
@@ -1048,6 +1673,44 @@ void CP2130::writePROMConfig(const PROMConfig &config, int &errcnt, std::string
         }
         controlTransfer(SET, SET_PROM_CONFIG, PROM_WRITE_KEY, static_cast<uint16_t>(i), controlBufferOut, SET_PROM_CONFIG_WLEN, errcnt, errstr);
     }
+    invalidateDescCache();  // The descriptors are also overwritten
+}
+
+// Writes the given configuration over the CP2130 OTP ROM, but only to the blocks whose content differs from the current one (added in version 1.3.0)
+// Unlike writePROMConfig(), this procedure refuses to write if any of the changed fields is already locked, or if the new lock word would unlock any field
+void CP2130::updatePROMConfig(const PROMConfig &config, int &errcnt, std::string &errstr)
+{
+    int preverrcnt = errcnt;
+    PROMConfig current = getPROMConfig(errcnt, errstr);
+    if (errcnt == preverrcnt) {  // Only proceed if the current configuration was read successfully, since every decision below depends on it
+        uint16_t currentLockWord = current.getLockWord();
+        uint16_t newLockWord = config.getLockWord();
+        if ((LWALL & current.changedFields(config) & ~currentLockWord) != 0x0000) {  // A cleared lock bit means that the corresponding field is locked
+            ++errcnt;
+            errstr += "In updatePROMConfig(): cannot modify fields that are locked.\n";  // Program logic error
+        } else if ((newLockWord & ~currentLockWord) != 0x0000) {
+            ++errcnt;
+            errstr += "In updatePROMConfig(): cannot unlock fields that are already locked.\n";  // Program logic error
+        } else {
+            for (size_t i = 0; i < PROM_BLOCKS; ++i) {
+                bool changed = false;
+                for (size_t j = 0; j < PROM_BLOCK_SIZE; ++j) {
+                    if (config.blocks[i][j] != current.blocks[i][j]) {
+                        changed = true;
+                        break;
+                    }
+                }
+                if (changed) {  // Blocks that are identical to the ones stored are skipped
+                    unsigned char controlBufferOut[SET_PROM_CONFIG_WLEN];
+                    for (size_t j = 0; j < PROM_BLOCK_SIZE; ++j) {
+                        controlBufferOut[j] = config.blocks[i][j];
+                    }
+                    controlTransfer(SET, SET_PROM_CONFIG, PROM_WRITE_KEY, static_cast<uint16_t>(i), controlBufferOut, SET_PROM_CONFIG_WLEN, errcnt, errstr);
+                }
+            }
+            invalidateDescCache();
+        }
+    }
 }
 
 // Writes the serial descriptor to the CP2130 OTP ROM
@@ -1058,6 +1721,7 @@ void CP2130::writeSerialDesc(const std::u16string &serial, int &errcnt, std::str
         errstr += "In writeSerialDesc(): serial descriptor string cannot be longer than 30 characters.\n";  // Program logic error
     } else {
         writeDescGeneric(serial, SET_SERIAL_STRING, errcnt, errstr);  // Refactored in version 1.1.0
+        serialCached_ = false;
     }
 }
 
@@ -1076,10 +1740,11 @@ void CP2130::writeUSBConfig(const USBConfig &config, uint8_t mask, int &errcnt,
     controlTransfer(SET, SET_USB_CONFIG, PROM_WRITE_KEY, 0x0000, controlBufferOut, SET_USB_CONFIG_WLEN, errcnt, errstr);
 }
 
-// Helper function to list devices
-std::list<std::string> CP2130::listDevices(uint16_t vid, uint16_t pid, int &errcnt, std::string &errstr)
+// Helper function to enumerate devices, returning their serial numbers along with their locations (added in version 1.3.0)
+// A DeviceInfo structure can be passed to open(), so that the device is opened without scanning the bus again; the manufacturer and product strings are only read if "strings" is true
+std::list<CP2130::DeviceInfo> CP2130::enumerateDevices(uint16_t vid, uint16_t pid, bool strings, int &errcnt, std::string &errstr)
 {
-    std::list<std::string> devices;
+    std::list<DeviceInfo> devices;
     libusb_context *context;
     if (libusb_init(&context) != 0) {  // Initialize libusb. In case of failure
         ++errcnt;
@@ -1091,17 +1756,62 @@ std::list<std::string> CP2130::listDevices(uint16_t vid, uint16_t pid, int &errc
             ++errcnt;
             errstr += "Failed to retrieve a list of devices.\n";
         } else {
+            std::vector<libusb_device *> matches;
+            std::vector<libusb_device_descriptor> descs;
             for (ssize_t i = 0; i < devlist; ++i) {  // Run through all listed devices
                 libusb_device_descriptor desc;
                 if (libusb_get_device_descriptor(devs[i], &desc) == 0 && desc.idVendor == vid && desc.idProduct == pid) {  // If the device descriptor is retrieved, and both VID and PID correspond to the respective given values
+                    matches.push_back(devs[i]);
+                    descs.push_back(desc);
+                }
+            }
+            std::vector<DeviceInfo> infos(matches.size());
+            std::vector<char> opened(matches.size(), 0);  // Note that std::vector<bool> is avoided, since its elements cannot be written concurrently
+            std::atomic<size_t> next(0);
+            auto query = [&]() {  // Since each query is dominated by the latency of its control transfers, these are distributed among a bounded number of threads (implemented in version 1.3.0)
+                size_t i;
+                while ((i = next++) < matches.size()) {
                     libusb_device_handle *handle;
-                    if (libusb_open(devs[i], &handle) == 0) {  // Open the listed device. If successfull
+                    if (libusb_open(matches[i], &handle) == 0) {  // Open the listed device. If successfull
+                        infos[i].bus = libusb_get_bus_number(matches[i]);
+                        infos[i].address = libusb_get_device_address(matches[i]);
+                        uint8_t ports[7];  // As per the USB 3.0 specification, the maximum hub depth is limited to 7
+                        int nports = libusb_get_port_numbers(matches[i], ports, static_cast<int>(sizeof(ports)));
+                        infos[i].ports.assign(ports, ports + (nports > 0 ? nports : 0));
                         unsigned char str_desc[256];
-                        libusb_get_string_descriptor_ascii(handle, desc.iSerialNumber, str_desc, static_cast<int>(sizeof(str_desc)));  // Get the serial number string in ASCII format
-                        devices.push_back(reinterpret_cast<char *>(str_desc));  // Add the serial number string to the list
+                        libusb_get_string_descriptor_ascii(handle, descs[i].iSerialNumber, str_desc, static_cast<int>(sizeof(str_desc)));  // Get the serial number string in ASCII format
+                        infos[i].serial = reinterpret_cast<char *>(str_desc);
+                        if (strings) {
+                            if (libusb_get_string_descriptor_ascii(handle, descs[i].iManufacturer, str_desc, static_cast<int>(sizeof(str_desc))) >= 0) {  // Get the manufacturer string in ASCII format
+                                infos[i].manufacturer = reinterpret_cast<char *>(str_desc);
+                            }
+                            if (libusb_get_string_descriptor_ascii(handle, descs[i].iProduct, str_desc, static_cast<int>(sizeof(str_desc))) >= 0) {  // Get the product string in ASCII format
+                                infos[i].product = reinterpret_cast<char *>(str_desc);
+                            }
+                        }
+                        opened[i] = 1;
                         libusb_close(handle);  // Close the device
                     }
                 }
+            };
+            size_t nthreads = matches.size() < ENUM_MAXTHREADS ? matches.size() : ENUM_MAXTHREADS;
+            std::vector<std::thread> threads;
+            threads.reserve(nthreads);  // Reserved beforehand, so that adding a thread that was already started cannot fail
+            for (size_t i = 1; i < nthreads; ++i) {  // The calling thread also takes part, hence the one less thread
+                try {
+                    threads.emplace_back(query);
+                } catch (const std::system_error &) {  // If a thread cannot be started, the queries are left to the threads already started, which are still joined below
+                    break;
+                }
+            }
+            query();
+            for (std::thread &thread : threads) {
+                thread.join();
+            }
+            for (size_t i = 0; i < matches.size(); ++i) {  // Devices are added in the same order as they were listed
+                if (opened[i] != 0) {
+                    devices.push_back(infos[i]);  // Add the device to the list
+                }
             }
             libusb_free_device_list(devs, 1);  // Free device list
         }
@@ -1109,3 +1819,59 @@ std::list<std::string> CP2130::listDevices(uint16_t vid, uint16_t pid, int &errc
     }
     return devices;
 }
+
+// Helper function that returns the upper bound, in microseconds, of the given latency histogram bucket (added in version 1.3.0)
+// Bounds double from one bucket to the next, starting at 16us, and the last bucket is unbounded
+uint32_t CP2130::latencyBound(size_t bucket)
+{
+    return bucket < LATENCY_BUCKETS - 1 ? static_cast<uint32_t>(16) << bucket : UINT32_MAX;
+}
+
+// Helper function to list devices
+std::list<std::string> CP2130::listDevices(uint16_t vid, uint16_t pid, int &errcnt, std::string &errstr)
+{
+    std::list<std::string> devices;
+    for (const DeviceInfo &device : enumerateDevices(vid, pid, false, errcnt, errstr)) {  // Refactored in version 1.3.0
+        devices.push_back(device.serial);  // Add the serial number string to the list
+    }
+    return devices;
+}
+
+// Helper function to load an OTP ROM image from a file, either in raw binary format (512 bytes) or in hexadecimal text format (added in version 1.3.0)
+// In the latter case, whitespace is ignored, so that hex dumps may be split into multiple lines
+CP2130::PROMConfig CP2130::loadPROMConfig(const std::string &filename, int &errcnt, std::string &errstr)
+{
+    PROMConfig config = {};  // All blocks are zeroed so that nothing undefined is returned in case of failure
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        ++errcnt;
+        errstr += "Could not open \"" + filename + "\".\n";
+    } else {
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        if (content.size() == PROM_SIZE) {  // Raw binary image
+            for (size_t i = 0; i < PROM_SIZE; ++i) {
+                config[i] = static_cast<uint8_t>(content[i]);
+            }
+        } else {  // Hexadecimal image
+            size_t ndigits = 0;
+            bool valid = true;
+            for (char c : content) {
+                if (std::isxdigit(static_cast<unsigned char>(c))) {
+                    if (ndigits < 2 * PROM_SIZE) {
+                        uint8_t nibble = static_cast<uint8_t>(std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : std::tolower(static_cast<unsigned char>(c)) - 'a' + 10);
+                        config[ndigits / 2] = static_cast<uint8_t>(config[ndigits / 2] << 4 | nibble);
+                    }
+                    ++ndigits;
+                } else if (!std::isspace(static_cast<unsigned char>(c))) {
+                    valid = false;
+                    break;
+                }
+            }
+            if (!valid || ndigits != 2 * PROM_SIZE) {
+                ++errcnt;
+                errstr += "\"" + filename + "\" is not a valid OTP ROM image.\n";
+            }
+        }
+    }
+    return config;
+}
@@ -1,4 +1,4 @@
-/* CP2130 class - Version 1.2.6
+/* CP2130 class - Version 1.3.0
    Copyright (c) 2021-2024 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
@@ -22,20 +22,39 @@
 #define CP2130_H
 
 // Includes
+#include <atomic>
 #include <cstdint>
 #include <list>
 #include <string>
 #include <vector>
 #include <libusb-1.0/libusb.h>
 
+// Interface of an alternative transport that serves the transfers of an open device instead of libusb, as implemented by CP2130Sim (added in version 1.3.0)
+// Both functions have the same semantics as their libusb counterparts, minus the timeout
+class CP2130Transport
+{
+public:
+    virtual ~CP2130Transport();
+
+    virtual int bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred) = 0;
+    virtual int controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength) = 0;
+};
+
 class CP2130
 {
 private:
     libusb_context *context_;
     libusb_device_handle *handle_;
-    bool disconnected_, kernelWasAttached_;
-
+    CP2130Transport *transport_;
+    std::atomic<bool> open_, disconnected_;  // Atomic, so that isOpen() and disconnected() can be called from any thread
+    bool kernelWasAttached_;
+    bool manufacturerCached_, productCached_, serialCached_;
+    std::u16string manufacturerDesc_, productDesc_, serialDesc_;
+
+    int claimDevice();
+    std::u16string getDescCached(uint8_t command, std::u16string &cache, bool &cached, int &errcnt, std::string &errstr);
     std::u16string getDescGeneric(uint8_t command, int &errcnt, std::string &errstr);
+    void invalidateDescCache();
     void writeDescGeneric(const std::u16string &descriptor, uint8_t command, int &errcnt, std::string &errstr);
 
 public:
@@ -47,6 +66,12 @@ public:
     static const int ERROR_NOT_FOUND = 2;  // Returned by open() if the device was not found
     static const int ERROR_BUSY = 3;       // Returned by open() if the device is already in use
 
+    // Flight recorder specific definitions
+    static const size_t RECORDER_SIZE = 256;  // Number of operations kept by the flight recorder
+
+    // Statistics specific definitions
+    static const size_t LATENCY_BUCKETS = 16;  // Number of buckets of the latency histogram (see latencyBound())
+
     // Descriptor specific definitions
     static const size_t DESCMXL_MANUFACTURER = 62;  // Maximum length of manufacturer descriptor
     static const size_t DESCMXL_PRODUCT = 62;       // Maximum length of product descriptor
@@ -242,6 +267,18 @@ public:
     static const uint8_t PRIOREAD = 0x00;     // Value corresponding to data transfer with high priority read
     static const uint8_t PRIOWRITE = 0x01;    // Value corresponding to data transfer with high priority write
 
+    struct DeviceInfo {
+        uint8_t bus;                 // Bus number
+        uint8_t address;             // Device address, as assigned on enumeration
+        std::vector<uint8_t> ports;  // Port numbers from the root hub to the device, as reported by libusb_get_port_numbers()
+        std::string serial;          // Serial number
+        std::string manufacturer;    // Manufacturer string (only filled if requested)
+        std::string product;         // Product string (only filled if requested)
+
+        bool operator ==(const DeviceInfo &other) const;
+        bool operator !=(const DeviceInfo &other) const;
+    };
+
     struct EventCounter {
         bool overflow;   // Overflow flag
         uint8_t mode;    // GPIO.4/EVTCNTR pin mode (see the values applicable to PinConfig/getPinConfig()/writePinConfig())
@@ -251,6 +288,22 @@ public:
         bool operator !=(const EventCounter &other) const;
     };
 
+    struct OperationRecord {
+        uint64_t sequence;    // Sequence number, counting from the creation of the object
+        uint64_t timestamp;   // Start time, in microseconds (steady clock)
+        uint32_t duration;    // Duration, in microseconds
+        bool bulk;            // True for a bulk transfer, false for a control transfer
+        uint8_t requestType;  // Request type (control transfers only)
+        uint8_t request;      // Request (control transfers) or endpoint address (bulk transfers)
+        uint16_t value;       // Value field (control transfers only)
+        uint16_t index;       // Index field (control transfers only)
+        int length;           // Requested length
+        int result;           // Value returned by libusb
+
+        bool operator ==(const OperationRecord &other) const;
+        bool operator !=(const OperationRecord &other) const;
+    };
+
     struct PinConfig {
         uint8_t gpio0;       // GPIO.0 pin config
         uint8_t gpio1;       // GPIO.1 pin config
@@ -280,6 +333,37 @@ public:
         bool operator !=(const PROMConfig &other) const;
         uint8_t &operator [](size_t index);
         const uint8_t &operator [](size_t index) const;
+
+        uint16_t changedFields(const PROMConfig &other) const;
+        uint16_t getLockWord() const;
+        uint8_t getMajorRelease() const;
+        std::u16string getManufacturerDesc() const;
+        uint8_t getMaxPower() const;
+        uint8_t getMinorRelease() const;
+        uint16_t getPID() const;
+        PinConfig getPinConfig() const;
+        uint8_t getPowerMode() const;
+        std::u16string getProductDesc() const;
+        std::u16string getSerialDesc() const;
+        uint8_t getTransferPriority() const;
+        uint16_t getVID() const;
+        void setLockWord(uint16_t word);
+        void setMajorRelease(uint8_t majrel);
+        void setManufacturerDesc(const std::u16string &manufacturer, int &errcnt, std::string &errstr);
+        void setMaxPower(uint8_t maxpow);
+        void setMinorRelease(uint8_t minrel);
+        void setPID(uint16_t pid);
+        void setPinConfig(const PinConfig &config);
+        void setPowerMode(uint8_t powmode);
+        void setProductDesc(const std::u16string &product, int &errcnt, std::string &errstr);
+        void setSerialDesc(const std::u16string &serial, int &errcnt, std::string &errstr);
+        void setTransferPriority(uint8_t trfprio);
+        void setVID(uint16_t vid);
+        void validate(int &errcnt, std::string &errstr) const;
+
+    private:
+        std::u16string getDescGeneric(size_t index, size_t size) const;
+        void setDescGeneric(const std::u16string &descriptor, size_t index, size_t size);
     };
 
     struct SiliconVersion {
@@ -313,6 +397,20 @@ public:
         bool operator !=(const SPIMode &other) const;
     };
 
+    struct Statistics {
+        uint64_t controlTransfers;                 // Number of control transfers
+        uint64_t bulkTransfers;                    // Number of bulk transfers
+        uint64_t bytesIn;                          // Number of bytes received
+        uint64_t bytesOut;                         // Number of bytes sent
+        uint64_t errors;                           // Number of failed transfers
+        uint64_t reconnects;                       // Number of times the device was reopened after being disconnected
+        uint64_t latencySum;                       // Sum of the durations of all transfers, in microseconds
+        uint64_t latencyBuckets[LATENCY_BUCKETS];  // Number of transfers whose duration falls within each bucket (non-cumulative)
+
+        bool operator ==(const Statistics &other) const;
+        bool operator !=(const Statistics &other) const;
+    };
+
     struct USBConfig {
         uint16_t vid;     // Vendor ID (little-endian)
         uint16_t pid;     // Product ID (little-endian)
@@ -326,10 +424,28 @@ public:
         bool operator !=(const USBConfig &other) const;
     };
 
+private:
+    struct RecorderSlot {
+        std::atomic<uint64_t> state;  // Twice the sequence number of the stored record plus one, or an even value while the record is being written
+        OperationRecord record;       // Stored record
+    };
+
+    RecorderSlot recorder_[RECORDER_SIZE];
+    std::atomic<uint64_t> recorderHead_;
+    std::atomic<uint64_t> controlTransfers_, bulkTransfers_, bytesIn_, bytesOut_, errors_, reconnects_, latencySum_;
+    std::atomic<uint64_t> latencyBuckets_[LATENCY_BUCKETS];
+
+    void countTransfer(const OperationRecord &record, bool in, int bytes, bool failed);
+    void recordOperation(OperationRecord &record);
+
+public:
     CP2130();
     ~CP2130();
 
     bool disconnected() const;
+    std::string dumpRecentOperations() const;
+    std::vector<OperationRecord> getRecentOperations() const;
+    Statistics getStatistics() const;
     bool isOpen() const;
 
     void bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred, int &errcnt, std::string &errstr);
@@ -375,6 +491,9 @@ public:
     bool isRTRActive(int &errcnt, std::string &errstr);
     void lockOTP(int &errcnt, std::string &errstr);
     int open(uint16_t vid, uint16_t pid, const std::string &serial = std::string());
+    int open(uint16_t vid, uint16_t pid, const DeviceInfo &device);
+    int open(uint16_t vid, uint16_t pid, uint8_t bus, const std::vector<uint8_t> &ports);
+    int open(CP2130Transport *transport);
     void reset(int &errcnt, std::string &errstr);
     void selectCS(uint8_t channel, int &errcnt, std::string &errstr);
     void setClockDivider(uint8_t value, int &errcnt, std::string &errstr);
@@ -399,6 +518,7 @@ public:
     std::vector<uint8_t> spiWriteRead(const std::vector<uint8_t> &data, uint8_t endpointInAddr, uint8_t endpointOutAddr, int &errcnt, std::string &errstr);
     std::vector<uint8_t> spiWriteRead(const std::vector<uint8_t> &data, int &errcnt, std::string &errstr);
     void stopRTR(int &errcnt, std::string &errstr);
+    void updatePROMConfig(const PROMConfig &config, int &errcnt, std::string &errstr);
     void writeLockWord(uint16_t word, int &errcnt, std::string &errstr);
     void writeManufacturerDesc(const std::u16string &manufacturer, int &errcnt, std::string &errstr);
     void writePinConfig(const PinConfig &config, int &errcnt, std::string &errstr);
@@ -407,7 +527,10 @@ public:
     void writeSerialDesc(const std::u16string &serial, int &errcnt, std::string &errstr);
     void writeUSBConfig(const USBConfig &config, uint8_t mask, int &errcnt, std::string &errstr);
 
+    static std::list<DeviceInfo> enumerateDevices(uint16_t vid, uint16_t pid, bool strings, int &errcnt, std::string &errstr);
+    static uint32_t latencyBound(size_t bucket);
     static std::list<std::string> listDevices(uint16_t vid, uint16_t pid, int &errcnt, std::string &errstr);
+    static PROMConfig loadPROMConfig(const std::string &filename, int &errcnt, std::string &errstr);
 };
 
 #endif  // CP2130_H
@@ -0,0 +1,545 @@
+/* CP2130 simulator class - Version 1.0.0
+   Requires CP2130 class version 1.3.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include "cp2130sim.h"
+
+// Definitions
+const size_t DESC_TBLSIZE = 64;  // Descriptor table size, as exchanged via control transfers
+const size_t DESC_IDXINCR = 63;  // Number of bytes of each descriptor table that are stored in the OTP ROM
+
+// Locations of the descriptor tables in the OTP ROM, along with the respective lock bits
+const struct {
+    size_t index, size;
+    uint16_t lockmask;
+} DESC_TABLES[] = {
+    {CP2130::PROMIDX_MANUFACTURING_STRING_1, CP2130::PROMSZE_MANUFACTURING_STRING_1, 0x0020},
+    {CP2130::PROMIDX_MANUFACTURING_STRING_2, CP2130::PROMSZE_MANUFACTURING_STRING_2, 0x0040},
+    {CP2130::PROMIDX_PRODUCT_STRING_1, CP2130::PROMSZE_PRODUCT_STRING_1, 0x0100},
+    {CP2130::PROMIDX_PRODUCT_STRING_2, CP2130::PROMSZE_PRODUCT_STRING_2, 0x0200},
+    {CP2130::PROMIDX_SERIAL_STRING, CP2130::PROMSZE_SERIAL_STRING, CP2130::LWSER}
+};
+
+// Private procedure that emulates a bulk OUT transfer, which always carries a command header
+int CP2130Sim::handleBulkOut(const unsigned char *data, int length)
+{
+    int retval;
+    if (length < 8) {  // Any valid bulk OUT transfer must carry a full command header
+        retval = LIBUSB_ERROR_PIPE;
+    } else {
+        uint32_t bytes = static_cast<uint32_t>(data[7] << 24 | data[6] << 16 | data[5] << 8 | data[4]);  // Little-endian conversion
+        uint8_t channel = selectedChannel();
+        switch (data[2]) {
+            case CP2130::READ:
+            case CP2130::READWITHRTR:
+                pendingIn_.assign(bytes, 0x00);  // Nothing drives MISO, so zeros are read
+                retval = LIBUSB_SUCCESS;
+                break;
+            case CP2130::WRITE:
+            case CP2130::WRITEREAD:
+                if (channel < CHANNELS) {
+                    lastWrite_[channel].assign(data + 8, data + length);
+                }
+                if (data[2] == CP2130::WRITEREAD) {
+                    pendingIn_.assign(data + 8, data + length);  // MOSI is looped back to MISO
+                }
+                retval = LIBUSB_SUCCESS;
+                break;
+            default:
+                retval = LIBUSB_ERROR_PIPE;
+        }
+    }
+    return retval;
+}
+
+// Private procedure that emulates the commands of the Device-to-Host vendor requests
+int CP2130Sim::handleGet(uint8_t bRequest, uint16_t wIndex, unsigned char *data, uint16_t wLength)
+{
+    unsigned char buffer[CP2130::PROM_BLOCK_SIZE] = {0};  // Large enough for any response
+    size_t size;
+    switch (bRequest) {
+        case CP2130::GET_READONLY_VERSION:
+            buffer[0] = 0x01;  // Emulates silicon version A01
+            buffer[1] = 0x01;
+            size = CP2130::GET_READONLY_VERSION_WLEN;
+            break;
+        case CP2130::GET_GPIO_VALUES:
+            buffer[0] = static_cast<uint8_t>(gpios_ >> 8);
+            buffer[1] = static_cast<uint8_t>(gpios_);
+            size = CP2130::GET_GPIO_VALUES_WLEN;
+            break;
+        case CP2130::GET_GPIO_MODE_AND_LEVEL:
+            buffer[2] = static_cast<uint8_t>(gpios_ >> 8);  // Pin modes are not emulated, and are thus reported as zero
+            buffer[3] = static_cast<uint8_t>(gpios_);
+            size = CP2130::GET_GPIO_MODE_AND_LEVEL_WLEN;
+            break;
+        case CP2130::GET_GPIO_CHIP_SELECT:
+            buffer[0] = static_cast<uint8_t>(cs_ >> 8);
+            buffer[1] = static_cast<uint8_t>(cs_);
+            buffer[2] = static_cast<uint8_t>(cs_ >> 8);
+            buffer[3] = static_cast<uint8_t>(cs_);
+            size = CP2130::GET_GPIO_CHIP_SELECT_WLEN;
+            break;
+        case CP2130::GET_SPI_WORD:
+            std::memcpy(buffer, spiWords_, CHANNELS);
+            size = CP2130::GET_SPI_WORD_WLEN;
+            break;
+        case CP2130::GET_SPI_DELAY:
+            if (wIndex < CHANNELS) {
+                std::memcpy(buffer, spiDelays_[wIndex], CP2130::GET_SPI_DELAY_WLEN);
+            }
+            size = CP2130::GET_SPI_DELAY_WLEN;
+            break;
+        case CP2130::GET_FULL_THRESHOLD:
+            buffer[0] = threshold_;
+            size = CP2130::GET_FULL_THRESHOLD_WLEN;
+            break;
+        case CP2130::GET_RTR_STATE:
+            size = CP2130::GET_RTR_STATE_WLEN;  // ReadWithRTR is never left active
+            break;
+        case CP2130::GET_EVENT_COUNTER:
+            if ((0x07 & eventCounter_[0]) >= CP2130::PCEVTCNTRRE && eventRate_ > 0) {  // GPIO.4 is counting events, which arrive at the emulated rate since the counter was last written
+                double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - eventStart_).count();
+                uint64_t count = (static_cast<uint64_t>(eventCounter_[1]) << 8 | eventCounter_[2]) + static_cast<uint64_t>(eventRate_ * elapsed);
+                buffer[0] = static_cast<uint8_t>((count > 0xffff ? 0x80 : 0x00) | eventCounter_[0]);
+                buffer[1] = static_cast<uint8_t>(count >> 8);
+                buffer[2] = static_cast<uint8_t>(count);
+            } else {
+                std::memcpy(buffer, eventCounter_, CP2130::GET_EVENT_COUNTER_WLEN);
+            }
+            size = CP2130::GET_EVENT_COUNTER_WLEN;
+            break;
+        case CP2130::GET_CLOCK_DIVIDER:
+            buffer[0] = clockDivider_;
+            size = CP2130::GET_CLOCK_DIVIDER_WLEN;
+            break;
+        case CP2130::GET_USB_CONFIG:
+            std::memcpy(buffer, prom_ + CP2130::PROMIDX_VID, CP2130::GET_USB_CONFIG_WLEN);  // The USB configuration is stored contiguously in the OTP ROM
+            size = CP2130::GET_USB_CONFIG_WLEN;
+            break;
+        case CP2130::GET_MANUFACTURING_STRING_1:
+        case CP2130::GET_MANUFACTURING_STRING_2:
+        case CP2130::GET_PRODUCT_STRING_1:
+        case CP2130::GET_PRODUCT_STRING_2:
+        case CP2130::GET_SERIAL_STRING:
+        {
+            size_t table = (bRequest - CP2130::GET_MANUFACTURING_STRING_1) / 2;
+            std::memcpy(buffer, prom_ + DESC_TABLES[table].index, DESC_TABLES[table].size);
+            size = DESC_TBLSIZE;
+            break;
+        }
+        case CP2130::GET_PIN_CONFIG:
+            std::memcpy(buffer, prom_ + CP2130::PROMIDX_PIN_CONFIG, CP2130::GET_PIN_CONFIG_WLEN);
+            size = CP2130::GET_PIN_CONFIG_WLEN;
+            break;
+        case CP2130::GET_LOCK_BYTE:
+            std::memcpy(buffer, prom_ + CP2130::PROMIDX_LOCK_BYTE, CP2130::GET_LOCK_BYTE_WLEN);
+            size = CP2130::GET_LOCK_BYTE_WLEN;
+            break;
+        case CP2130::GET_PROM_CONFIG:
+            if (wIndex < CP2130::PROM_BLOCKS) {
+                std::memcpy(buffer, prom_ + CP2130::PROM_BLOCK_SIZE * wIndex, CP2130::PROM_BLOCK_SIZE);
+            }
+            size = CP2130::GET_PROM_CONFIG_WLEN;
+            break;
+        default:
+            size = 0;
+    }
+    int retval;
+    if (size == 0) {  // Unknown commands are stalled, as the real device would
+        retval = LIBUSB_ERROR_PIPE;
+    } else {
+        size_t count = wLength < size ? wLength : size;
+        std::memcpy(data, buffer, count);
+        retval = static_cast<int>(count);
+    }
+    return retval;
+}
+
+// Private procedure that emulates the commands of the Host-to-Device vendor requests
+int CP2130Sim::handleSet(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, const unsigned char *data, uint16_t wLength)
+{
+    int retval = wLength;
+    switch (bRequest) {
+        case CP2130::RESET_DEVICE:
+            resetState();
+            break;
+        case CP2130::SET_GPIO_VALUES:
+        {
+            uint16_t values = static_cast<uint16_t>(data[0] << 8 | data[1]);
+            uint16_t mask = static_cast<uint16_t>(CP2130::BMGPIOS & (data[2] << 8 | data[3]));
+            gpios_ = static_cast<uint16_t>((gpios_ & ~mask) | (values & mask));
+            break;
+        }
+        case CP2130::SET_GPIO_MODE_AND_LEVEL:
+            if (data[0] > 10) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                uint16_t bitmap = static_cast<uint16_t>(data[0] < 6 ? CP2130::BMGPIO0 << data[0] : CP2130::BMGPIO6 << (data[0] - 6));
+                gpios_ = static_cast<uint16_t>(data[2] != 0x00 ? gpios_ | bitmap : gpios_ & ~bitmap);
+            }
+            break;
+        case CP2130::SET_GPIO_CHIP_SELECT:
+            if (data[0] >= CHANNELS) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else if (data[1] == 0x00) {
+                cs_ = static_cast<uint16_t>(cs_ & ~(0x0001 << data[0]));
+            } else if (data[1] == 0x01) {
+                cs_ = static_cast<uint16_t>(cs_ | 0x0001 << data[0]);
+            } else {
+                cs_ = static_cast<uint16_t>(0x0001 << data[0]);
+            }
+            break;
+        case CP2130::SET_SPI_WORD:
+            if (data[0] >= CHANNELS) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                spiWords_[data[0]] = data[1];
+            }
+            break;
+        case CP2130::SET_SPI_DELAY:
+            if (data[0] >= CHANNELS) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                std::memcpy(spiDelays_[data[0]], data, CP2130::SET_SPI_DELAY_WLEN);
+            }
+            break;
+        case CP2130::SET_FULL_THRESHOLD:
+            threshold_ = data[0];
+            break;
+        case CP2130::SET_RTR_STOP:
+            break;
+        case CP2130::SET_EVENT_COUNTER:
+            eventCounter_[0] = static_cast<uint8_t>(0x07 & data[0]);  // Writing to the event counter also clears the overflow bit
+            eventCounter_[1] = data[1];
+            eventCounter_[2] = data[2];
+            eventStart_ = std::chrono::steady_clock::now();
+            break;
+        case CP2130::SET_CLOCK_DIVIDER:
+            clockDivider_ = data[0];
+            break;
+        case CP2130::SET_USB_CONFIG:
+        {
+            static const struct {
+                uint8_t mask;
+                size_t index, size;
+            } FIELDS[] = {
+                {CP2130::LWVID, CP2130::PROMIDX_VID, CP2130::PROMSZE_VID},
+                {CP2130::LWPID, CP2130::PROMIDX_PID, CP2130::PROMSZE_PID},
+                {CP2130::LWMAXPOW, CP2130::PROMIDX_MAX_POWER, CP2130::PROMSZE_MAX_POWER},
+                {CP2130::LWPOWMODE, CP2130::PROMIDX_POWER_MODE, CP2130::PROMSZE_POWER_MODE},
+                {CP2130::LWREL, CP2130::PROMIDX_RELEASE_VERSION, CP2130::PROMSZE_RELEASE_VERSION},
+                {CP2130::LWTRFPRIO, CP2130::PROMIDX_TRANSFER_PRIORITY, CP2130::PROMSZE_TRANSFER_PRIORITY}
+            };
+            if (wValue != CP2130::PROM_WRITE_KEY || isLocked(data[9])) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                for (const auto &field : FIELDS) {
+                    if ((field.mask & data[9]) != 0x00) {
+                        std::memcpy(prom_ + field.index, data + field.index, field.size);  // The USB configuration layout matches the one of the OTP ROM
+                    }
+                }
+            }
+            break;
+        }
+        case CP2130::SET_MANUFACTURING_STRING_1:
+        case CP2130::SET_MANUFACTURING_STRING_2:
+        case CP2130::SET_PRODUCT_STRING_1:
+        case CP2130::SET_PRODUCT_STRING_2:
+        case CP2130::SET_SERIAL_STRING:
+        {
+            size_t table = (bRequest - CP2130::SET_MANUFACTURING_STRING_1) / 2;
+            if (wValue != CP2130::PROM_WRITE_KEY || isLocked(DESC_TABLES[table].lockmask)) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                std::memcpy(prom_ + DESC_TABLES[table].index, data, DESC_TABLES[table].size);
+            }
+            break;
+        }
+        case CP2130::SET_PIN_CONFIG:
+            if (wValue != CP2130::PROM_WRITE_KEY || isLocked(CP2130::LWPINCFG)) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                std::memcpy(prom_ + CP2130::PROMIDX_PIN_CONFIG, data, CP2130::SET_PIN_CONFIG_WLEN);
+            }
+            break;
+        case CP2130::SET_LOCK_BYTE:
+            if (wValue != CP2130::PROM_WRITE_KEY) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                prom_[CP2130::PROMIDX_LOCK_BYTE] &= data[0];  // Being an OTP ROM, bits can only be cleared
+                prom_[CP2130::PROMIDX_LOCK_BYTE + 1] &= data[1];
+            }
+            break;
+        case CP2130::SET_PROM_CONFIG:
+            if (wValue != CP2130::PROM_WRITE_KEY || wIndex >= CP2130::PROM_BLOCKS) {
+                retval = LIBUSB_ERROR_PIPE;
+            } else {
+                std::memcpy(prom_ + CP2130::PROM_BLOCK_SIZE * wIndex, data, CP2130::PROM_BLOCK_SIZE);
+            }
+            break;
+        default:
+            retval = LIBUSB_ERROR_PIPE;
+    }
+    return retval;
+}
+
+// Private procedure that returns true if any of the fields given by the mask are locked in the OTP ROM
+bool CP2130Sim::isLocked(uint16_t mask) const
+{
+    uint16_t lockWord = static_cast<uint16_t>(prom_[CP2130::PROMIDX_LOCK_BYTE + 1] << 8 | prom_[CP2130::PROMIDX_LOCK_BYTE]);  // Little-endian conversion
+    return (lockWord & mask) != mask;  // A field is locked if any of its lock bits is cleared
+}
+
+// Private procedure that restores the volatile state, as it would be after a power-on or device reset
+void CP2130Sim::resetState()
+{
+    gpios_ = CP2130::BMGPIOS;  // All GPIOs idle high
+    cs_ = 0x0000;
+    clockDivider_ = prom_[CP2130::PROMIDX_PIN_CONFIG + CP2130::PROMSZE_PIN_CONFIG - 1];  // The clock divider is loaded from the pin configuration
+    threshold_ = 0x00;
+    for (size_t i = 0; i < CHANNELS; ++i) {
+        spiWords_[i] = 0x00;
+        std::memset(spiDelays_[i], 0x00, CP2130::SET_SPI_DELAY_WLEN);
+        spiDelays_[i][0] = static_cast<uint8_t>(i);  // Byte 0 always holds the channel
+        lastWrite_[i].clear();
+    }
+    std::memset(eventCounter_, 0x00, CP2130::GET_EVENT_COUNTER_WLEN);
+    eventStart_ = std::chrono::steady_clock::now();
+    pendingIn_.clear();
+}
+
+// Private procedure that returns the lowest channel whose chip select is enabled, or "CHANNELS" [11] if none is
+uint8_t CP2130Sim::selectedChannel() const
+{
+    uint8_t channel = 0;
+    while (channel < CHANNELS && (0x0001 << channel & cs_) == 0x0000) {
+        ++channel;
+    }
+    return channel;
+}
+
+// Private procedure that stores a descriptor in the OTP ROM, spanning the given number of tables
+void CP2130Sim::setDesc(size_t table, size_t ntables, const std::u16string &descriptor)
+{
+    std::vector<uint8_t> stream(DESC_IDXINCR * ntables, 0x00);
+    size_t length = 2 * descriptor.size() + 2;
+    stream[0] = static_cast<uint8_t>(length);  // USB string descriptor length
+    stream[1] = 0x03;                          // USB string descriptor constant
+    for (size_t i = 0; i < descriptor.size() && 2 * i + 3 < stream.size(); ++i) {
+        stream[2 * i + 2] = static_cast<uint8_t>(descriptor[i]);  // UTF-16LE conversion as per the USB 2.0 specification
+        stream[2 * i + 3] = static_cast<uint8_t>(descriptor[i] >> 8);
+    }
+    for (size_t i = 0; i < ntables; ++i) {
+        std::memcpy(prom_ + DESC_TABLES[table + i].index, stream.data() + DESC_IDXINCR * i, DESC_TABLES[table + i].size);
+    }
+}
+
+// Private procedure that emulates the latency of a transfer
+// Busy-waiting is used because sleeping is not accurate at the microsecond scale
+void CP2130Sim::wait() const
+{
+    if (latency_ > 0) {
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds(latency_);
+        while (std::chrono::steady_clock::now() < end) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+// "CP2130Sim" class constructor
+CP2130Sim::CP2130Sim() :
+    mutex_(),
+    latency_(0),
+    gpios_(0x0000),
+    cs_(0x0000),
+    clockDivider_(0x00),
+    threshold_(0x00),
+    spiWords_(),
+    spiDelays_(),
+    eventCounter_(),
+    eventRate_(0),
+    eventStart_(),
+    prom_(),
+    lastWrite_(),
+    pendingIn_(),
+    transfers_(0)
+{
+    std::memset(prom_, 0xff, CP2130::PROM_SIZE);  // A blank OTP ROM reads as all ones, including the lock word
+    setUSBConfig({CP2130::VID, CP2130::PID, 0x01, 0x00, 0x32, CP2130::PMBUSREGEN, CP2130::PRIOWRITE});
+    setDesc(0, 2, u"Silicon Laboratories");
+    setDesc(2, 2, u"CP2130 USB-to-SPI Bridge");
+    setDesc(4, 1, u"SIM00001");
+    const uint8_t PIN_CONFIG[CP2130::PROMSZE_PIN_CONFIG] = {
+        CP2130::PCCS, CP2130::PCCS,                                                            // GPIO.0 and GPIO.1 as chip selects
+        CP2130::PCOUTPP, CP2130::PCOUTPP, CP2130::PCOUTPP, CP2130::PCOUTPP, CP2130::PCOUTPP,  // GPIO.2 to GPIO.6 as push-pull outputs
+        CP2130::PCIN, CP2130::PCIN, CP2130::PCIN, CP2130::PCIN,                                // GPIO.7 to GPIO.10 as inputs
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,                                        // Suspend and wakeup bitmaps
+        0x00                                                                                   // Clock divider
+    };
+    std::memcpy(prom_ + CP2130::PROMIDX_PIN_CONFIG, PIN_CONFIG, CP2130::PROMSZE_PIN_CONFIG);
+    resetState();
+}
+
+// Returns the chip select status of all channels, in bitmap format
+uint16_t CP2130Sim::getCS() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cs_;
+}
+
+// Returns the value of all GPIO pins, in bitmap format
+uint16_t CP2130Sim::getGPIOs() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return gpios_;
+}
+
+// Returns the data of the last SPI write (or write-read) performed on the given channel
+std::vector<uint8_t> CP2130Sim::getLastSPIWrite(uint8_t channel) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return channel < CHANNELS ? lastWrite_[channel] : std::vector<uint8_t>();
+}
+
+// Returns the emulated rate of the events fed to GPIO.4, in events per second
+double CP2130Sim::getEventRate() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return eventRate_;
+}
+
+// Returns the emulated latency of each transfer, in microseconds
+uint32_t CP2130Sim::getLatency() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return latency_;
+}
+
+// Returns the number of transfers served so far
+uint64_t CP2130Sim::getTransferCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return transfers_;
+}
+
+// Emulates a bulk transfer, with the same semantics as libusb_bulk_transfer()
+// Since the bus is occupied for the duration of the transfer, concurrent transfers are serialized
+int CP2130Sim::bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++transfers_;
+    wait();
+    bool prioWrite = prom_[CP2130::PROMIDX_TRANSFER_PRIORITY] == CP2130::PRIOWRITE;  // The endpoint addresses depend on the transfer priority, as with the real device
+    int count = 0;
+    int retval;
+    if (endpointAddr == (prioWrite ? 0x01 : 0x02)) {
+        retval = handleBulkOut(data, length);
+        count = retval == LIBUSB_SUCCESS ? length : 0;
+    } else if (endpointAddr == (prioWrite ? 0x82 : 0x81)) {
+        if (pendingIn_.empty()) {  // The real device would simply not respond
+            retval = LIBUSB_ERROR_TIMEOUT;
+        } else {
+            count = length < static_cast<int>(pendingIn_.size()) ? length : static_cast<int>(pendingIn_.size());
+            std::memcpy(data, pendingIn_.data(), static_cast<size_t>(count));
+            pendingIn_.erase(pendingIn_.begin(), pendingIn_.begin() + count);
+            retval = LIBUSB_SUCCESS;
+        }
+    } else {
+        retval = LIBUSB_ERROR_PIPE;
+    }
+    if (transferred != nullptr) {
+        *transferred = count;
+    }
+    return retval;
+}
+
+// Emulates a control transfer, with the same semantics as libusb_control_transfer()
+int CP2130Sim::controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++transfers_;
+    wait();
+    int retval;
+    if (bmRequestType == CP2130::GET) {
+        retval = handleGet(bRequest, wIndex, data, wLength);
+    } else if (bmRequestType == CP2130::SET) {
+        retval = handleSet(bRequest, wValue, wIndex, data, wLength);
+    } else {
+        retval = LIBUSB_ERROR_PIPE;
+    }
+    return retval;
+}
+
+// Restores the volatile state of the simulated device, as if it was power cycled
+void CP2130Sim::reset()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    resetState();
+}
+
+// Sets the emulated rate of the events fed to GPIO.4, in events per second, which are counted while GPIO.4 is in one of the event counter modes
+// This emulates a signal routed to the event counter input (e.g., a divided output of the waveform generator)
+void CP2130Sim::setEventRate(double rate)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    eventRate_ = rate;
+}
+
+// Drives the GPIO pins to the given values, in bitmap format (e.g., to emulate external circuitry)
+void CP2130Sim::setGPIOs(uint16_t bmValues)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    gpios_ = static_cast<uint16_t>(CP2130::BMGPIOS & bmValues);
+}
+
+// Sets the emulated latency of each transfer, in microseconds
+void CP2130Sim::setLatency(uint32_t latency)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    latency_ = latency;
+}
+
+// Sets the serial descriptor, bypassing the OTP ROM lock as factory programming would
+// Note that the descriptor is truncated to "DESCMXL_SERIAL" [30] characters
+void CP2130Sim::setSerialDesc(const std::u16string &serial)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    setDesc(4, 1, serial.substr(0, CP2130::DESCMXL_SERIAL));
+}
+
+// Sets the USB configuration, bypassing the OTP ROM lock as factory programming would
+void CP2130Sim::setUSBConfig(const CP2130::USBConfig &config)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint8_t usbConfig[CP2130::GET_USB_CONFIG_WLEN] = {
+        static_cast<uint8_t>(config.vid), static_cast<uint8_t>(config.vid >> 8),  // VID
+        static_cast<uint8_t>(config.pid), static_cast<uint8_t>(config.pid >> 8),  // PID
+        config.maxpow,                                                            // Maximum consumption current
+        config.powmode,                                                           // Power mode
+        config.majrel, config.minrel,                                             // Major and minor release versions
+        config.trfprio                                                            // Transfer priority
+    };
+    std::memcpy(prom_ + CP2130::PROMIDX_VID, usbConfig, CP2130::GET_USB_CONFIG_WLEN);
+}
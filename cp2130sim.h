@@ -0,0 +1,81 @@
+/* CP2130 simulator class - Version 1.0.0
+   Requires CP2130 class version 1.3.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef CP2130SIM_H
+#define CP2130SIM_H
+
+// Includes
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "cp2130.h"
+
+class CP2130Sim : public CP2130Transport
+{
+private:
+    static const size_t CHANNELS = 11;  // Number of SPI channels
+
+    mutable std::mutex mutex_;
+    uint32_t latency_;
+    uint16_t gpios_, cs_;
+    uint8_t clockDivider_, threshold_;
+    uint8_t spiWords_[CHANNELS];
+    uint8_t spiDelays_[CHANNELS][CP2130::SET_SPI_DELAY_WLEN];
+    uint8_t eventCounter_[CP2130::GET_EVENT_COUNTER_WLEN];
+    double eventRate_;
+    std::chrono::steady_clock::time_point eventStart_;
+    uint8_t prom_[CP2130::PROM_SIZE];
+    std::vector<uint8_t> lastWrite_[CHANNELS];
+    std::vector<uint8_t> pendingIn_;
+    uint64_t transfers_;
+
+    int handleBulkOut(const unsigned char *data, int length);
+    int handleGet(uint8_t bRequest, uint16_t wIndex, unsigned char *data, uint16_t wLength);
+    int handleSet(uint8_t bRequest, uint16_t wValue, uint16_t wIndex, const unsigned char *data, uint16_t wLength);
+    bool isLocked(uint16_t mask) const;
+    void resetState();
+    uint8_t selectedChannel() const;
+    void setDesc(size_t table, size_t ntables, const std::u16string &descriptor);
+    void wait() const;
+
+public:
+    CP2130Sim();
+
+    uint16_t getCS() const;
+    uint16_t getGPIOs() const;
+    std::vector<uint8_t> getLastSPIWrite(uint8_t channel) const;
+    double getEventRate() const;
+    uint32_t getLatency() const;
+    uint64_t getTransferCount() const;
+
+    int bulkTransfer(uint8_t endpointAddr, unsigned char *data, int length, int *transferred) override;
+    int controlTransfer(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, unsigned char *data, uint16_t wLength) override;
+    void reset();
+    void setEventRate(double rate);
+    void setGPIOs(uint16_t bmValues);
+    void setLatency(uint32_t latency);
+    void setSerialDesc(const std::u16string &serial);
+    void setUSBConfig(const CP2130::USBConfig &config);
+};
+
+#endif  // CP2130SIM_H
@@ -0,0 +1,249 @@
+/* GF2 calibration class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "gf2calibration.h"
+
+// Definitions
+const double FQUANTUM = 268435456;  // Quantum related to the 28-bit frequency resolution of the AD9834 waveform generator
+const double MCLK = 80000;          // 80MHz clock (nominal)
+
+// "Equal to" operator for Point
+bool GF2Calibration::Point::operator ==(const GF2Calibration::Point &other) const
+{
+    return frequency == other.frequency && error == other.error;
+}
+
+// "Not equal to" operator for Point
+bool GF2Calibration::Point::operator !=(const GF2Calibration::Point &other) const
+{
+    return !(operator ==(other));
+}
+
+// Private function that returns the bin of the segment table corresponding to the given frequency
+size_t GF2Calibration::bin(float frequency) const
+{
+    double position = std::min(std::max(static_cast<double>(frequency), 0.0), static_cast<double>(RANGE)) * BINS / RANGE;
+    return std::min(static_cast<size_t>(position), BINS - 1);
+}
+
+// Private function that returns the residual error (in ppm) at the given frequency, by linear interpolation between the correction points
+// Beyond the first and last points, their errors are held constant
+// The search starts from the segment stored for the bin, so that only the points that fall within that bin are visited
+double GF2Calibration::correction(float frequency) const
+{
+    double retval = 0;
+    if (!points_.empty()) {
+        size_t next = segments_[bin(frequency)];
+        while (next > 0 && points_[next - 1].frequency > frequency) {
+            --next;  // Only happens due to rounding, if the frequency lies right at the start of the bin
+        }
+        while (next < points_.size() && points_[next].frequency <= frequency) {
+            ++next;
+        }
+        if (next == 0) {
+            retval = points_.front().error;
+        } else if (next == points_.size()) {
+            retval = points_.back().error;
+        } else {
+            const Point &previous = points_[next - 1];
+            retval = previous.error + (points_[next].error - previous.error) * (frequency - previous.frequency) / (points_[next].frequency - previous.frequency);
+        }
+    }
+    return retval;
+}
+
+// Private function that returns the factor converting the given frequency (in KHz) into a tuning word
+double GF2Calibration::factor(float frequency) const
+{
+    return scale_ / (1 + correction(frequency) / 1000000);
+}
+
+// Private procedure used to recompute the segment table, after the master clock error or the correction points change
+void GF2Calibration::rebuild()
+{
+    scale_ = FQUANTUM / (MCLK * (1 + mclkError_ / 1000000));
+    for (size_t i = 0; i < BINS; ++i) {
+        float start = static_cast<float>(RANGE * i / BINS);
+        segments_[i] = static_cast<uint32_t>(std::upper_bound(points_.begin(), points_.end(), start, [](float value, const Point &point) {
+            return value < point.frequency;
+        }) - points_.begin());
+    }
+}
+
+// "GF2Calibration" class constructor
+// The calibration is initially the identity, which corresponds to an ideal master clock
+GF2Calibration::GF2Calibration() :
+    mclkError_(0),
+    points_(),
+    scale_(FQUANTUM / MCLK),
+    segments_(BINS, 0)
+{
+}
+
+// Returns the frequency (in KHz) that is actually generated when the given frequency is set, taking into account both the calibration and the 28-bit resolution
+float GF2Calibration::expectedFrequency(float frequency) const
+{
+    return static_cast<float>(frequencyCode(frequency) / factor(frequency));
+}
+
+// Returns the corrected 28-bit tuning word corresponding to the given frequency (in KHz)
+// Note that the function is only valid for values between 0 and "RANGE" [40000]
+uint32_t GF2Calibration::frequencyCode(float frequency) const
+{
+    return static_cast<uint32_t>(frequency * factor(frequency) + 0.5);
+}
+
+// Returns the measured error of the master clock, in ppm
+double GF2Calibration::getMCLKError() const
+{
+    return mclkError_;
+}
+
+// Returns the correction points, sorted by frequency
+std::vector<GF2Calibration::Point> GF2Calibration::getPoints() const
+{
+    return points_;
+}
+
+// Returns true if no correction is applied
+bool GF2Calibration::isIdentity() const
+{
+    return mclkError_ == 0 && points_.empty();
+}
+
+// Saves the calibration under the given serial number, in a text file shared by several devices
+// Each line of the file holds the serial number, the master clock error (in ppm) and any correction points (as KHZ:PPM pairs), separated by spaces
+// The line of the given device is replaced if present, and any other lines are kept as they are
+void GF2Calibration::save(const std::string &filename, const std::string &serial, int &errcnt, std::string &errstr) const
+{
+    if (serial.empty() || serial.find_first_of(" \t#") != std::string::npos) {
+        ++errcnt;
+        errstr += "In save(): Serial number must not be empty, and must not contain spaces or \"#\".\n";  // Program logic error
+    } else {
+        std::vector<std::string> lines;
+        std::ifstream input(filename);
+        std::string line;
+        while (std::getline(input, line)) {  // The file may not exist yet, in which case nothing is read
+            std::istringstream lineStream(line);
+            std::string first;
+            if (!(lineStream >> first) || first != serial) {
+                lines.push_back(line);
+            }
+        }
+        input.close();
+        std::ostringstream entry;
+        entry << serial << " " << std::setprecision(10) << mclkError_;
+        for (const Point &point : points_) {
+            entry << " " << point.frequency << ":" << point.error;
+        }
+        lines.push_back(entry.str());
+        std::ofstream output(filename, std::ios::trunc);
+        for (const std::string &outputLine : lines) {
+            output << outputLine << "\n";
+        }
+        output.close();
+        if (!output) {
+            ++errcnt;
+            errstr += "Could not write \"" + filename + "\".\n";
+        }
+    }
+}
+
+// Sets the measured error of the master clock, in ppm (a positive value means that the clock runs fast)
+void GF2Calibration::setMCLKError(double error, int &errcnt, std::string &errstr)
+{
+    if (!(std::fabs(error) <= ERROR_LIMIT)) {  // This also rejects NaN
+        ++errcnt;
+        errstr += "In setMCLKError(): Error must be between -10000 and 10000.\n";  // Program logic error
+    } else {
+        mclkError_ = error;
+        rebuild();
+    }
+}
+
+// Sets the correction points, which need not be sorted, replacing any previous ones (an empty vector removes the piecewise correction)
+void GF2Calibration::setPoints(const std::vector<Point> &points, int &errcnt, std::string &errstr)
+{
+    bool valid = true;
+    for (const Point &point : points) {
+        valid = valid && point.frequency >= 0 && point.frequency <= RANGE && std::fabs(point.error) <= ERROR_LIMIT;
+    }
+    if (!valid) {
+        ++errcnt;
+        errstr += "In setPoints(): Frequencies must be between 0 and 40000, and errors must be between -10000 and 10000.\n";  // Program logic error
+    } else {
+        points_ = points;
+        std::stable_sort(points_.begin(), points_.end(), [](const Point &a, const Point &b) {
+            return a.frequency < b.frequency;
+        });
+        rebuild();
+    }
+}
+
+// Loads the calibration saved under the given serial number (see save())
+// If the file does not hold a calibration for the given device, the identity is returned, since that device was never calibrated
+GF2Calibration GF2Calibration::load(const std::string &filename, const std::string &serial, int &errcnt, std::string &errstr)
+{
+    GF2Calibration calibration;
+    std::ifstream file(filename);
+    if (!file) {
+        ++errcnt;
+        errstr += "Could not open \"" + filename + "\".\n";
+    } else {
+        std::string line;
+        bool found = false;
+        while (!found && std::getline(file, line)) {
+            std::istringstream lineStream(line.substr(0, line.find('#')));
+            std::string first;
+            found = lineStream >> first && first == serial;
+            if (found) {
+                double mclkError;
+                std::vector<Point> points;
+                std::string field;
+                bool valid = static_cast<bool>(lineStream >> mclkError);
+                while (valid && lineStream >> field) {
+                    Point point;
+                    char separator;
+                    std::istringstream fieldStream(field);
+                    valid = fieldStream >> point.frequency >> separator >> point.error && separator == ':' && fieldStream.peek() == std::char_traits<char>::eof();
+                    points.push_back(point);
+                }
+                int errcntLoad = 0;
+                std::string errstrLoad;
+                if (valid) {
+                    calibration.setMCLKError(mclkError, errcntLoad, errstrLoad);
+                    calibration.setPoints(points, errcntLoad, errstrLoad);
+                }
+                if (!valid || errcntLoad > 0) {
+                    ++errcnt;
+                    errstr += "\"" + filename + "\" holds an invalid calibration for \"" + serial + "\".\n";
+                    calibration = GF2Calibration();
+                }
+            }
+        }
+    }
+    return calibration;
+}
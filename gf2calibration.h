@@ -0,0 +1,75 @@
+/* GF2 calibration class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2CALIBRATION_H
+#define GF2CALIBRATION_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Frequency calibration of a GF2 device, consisting of the measured error of its 80MHz master clock and, optionally, of a piecewise linear correction
+// The frequency range is divided into bins, each holding the first correction segment it overlaps, so that the correction is evaluated exactly in constant time
+class GF2Calibration
+{
+public:
+    // Class definitions
+    static const size_t BINS = 1024;              // Number of intervals of the segment table, spanning the frequency range
+    static constexpr float RANGE = 40000;         // Frequency range covered by the segment table, matching the range of GF2Device::setFrequency()
+    static constexpr double ERROR_LIMIT = 10000;  // Maximum absolute error, in ppm, accepted for both the master clock and the correction points
+
+    struct Point {
+        float frequency;  // Frequency (in KHz) at which the error was measured
+        double error;     // Residual error of the output frequency (in ppm), after correcting for the master clock error
+
+        bool operator ==(const Point &other) const;
+        bool operator !=(const Point &other) const;
+    };
+
+private:
+    double mclkError_;
+    std::vector<Point> points_;
+    double scale_;                    // Factor converting a frequency into a tuning word, given the master clock error alone
+    std::vector<uint32_t> segments_;  // Index of the first correction point above the start of each bin
+
+    size_t bin(float frequency) const;
+    double correction(float frequency) const;
+    double factor(float frequency) const;
+    void rebuild();
+
+public:
+    GF2Calibration();
+
+    float expectedFrequency(float frequency) const;
+    uint32_t frequencyCode(float frequency) const;
+    double getMCLKError() const;
+    std::vector<Point> getPoints() const;
+    bool isIdentity() const;
+
+    void save(const std::string &filename, const std::string &serial, int &errcnt, std::string &errstr) const;
+    void setMCLKError(double error, int &errcnt, std::string &errstr);
+    void setPoints(const std::vector<Point> &points, int &errcnt, std::string &errstr);
+
+    static GF2Calibration load(const std::string &filename, const std::string &serial, int &errcnt, std::string &errstr);
+};
+
+#endif  // GF2CALIBRATION_H
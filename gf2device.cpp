@@ -1,5 +1,5 @@
-/* GF2 device class - Version 1.0.1
-   Requires CP2130 class version 1.1.0 or later
+/* GF2 device class - Version 1.1.0
+   Requires CP2130 class version 1.3.0 or later
    Copyright (c) 2022 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
@@ -20,8 +20,10 @@
 
 
 // Includes
+#include <chrono>
 #include <cmath>
 #include <sstream>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 #include "gf2device.h"
@@ -33,6 +35,17 @@ const uint8_t FREQ1 = 0x80;   // Mask for the FREQ1 register
 const uint8_t PHASE0 = 0xc0;  // Mask for the PHASE0 register
 const uint8_t PHASE1 = 0xe0;  // Mask for the PHASE1 register
 
+// Bitmap for the control lines (GPIO.2 to GPIO.6), as kept in profiles
+const uint16_t BMLINES = CP2130::BMGPIO2 | CP2130::BMGPIO3 | CP2130::BMGPIO4 | CP2130::BMGPIO5 | CP2130::BMGPIO6;
+
+// Profile definitions
+const uint8_t PROFILE_MAGIC[2] = {'G', 'P'};  // Magic number identifying a profile
+const uint8_t PROFILE_VERSION = 0x01;         // Profile layout version
+
+// AD9834 control register bitmaps
+const uint16_t CTRLB28 = 0x2000;  // Bitmap for the B28 bit (tuning words are written as two consecutive 14-bit halves)
+const uint16_t CTRLHLB = 0x1000;  // Bitmap for the HLB bit (selects the 14 MSBs of a tuning word as the target of single writes, if B28 is cleared)
+
 // Amplitude conversion constant
 const uint AQUANTUM = 1023;  // Quantum related to the 10-bit resolution of the AD5310 DAC
 
@@ -43,8 +56,352 @@ const float MCLK = 80000;         // 80MHz clock
 // Phase conversion constant
 const uint PQUANTUM = 4096;  // Quantum related to the 12-bit phase resolution of the AD9834 waveform generator
 
+// Returns the 12-bit phase code of the AD9834 waveform generator corresponding to the given phase (in degrees)
+static uint16_t phaseCode(float phase)
+{
+    float phaseMod = std::fmod(phase, 360);  // Calculate the remainder of the division between the phase and 360
+    return static_cast<uint16_t>((phaseMod + (phaseMod < 0 ? 360 : 0)) * PQUANTUM / 360 + 0.5);
+}
+
+// Appends the SPI words that write the given code to the AD5310 DAC
+static void appendAmplitudeWrite(std::vector<uint8_t> &data, uint16_t code)
+{
+    data.push_back(static_cast<uint8_t>(0x0f & code >> 6));
+    data.push_back(static_cast<uint8_t>(code << 2));
+}
+
+// Appends the SPI words that write the given tuning word to the FREQ0 or FREQ1 register of the AD9834, according to the boolean variable "fsel"
+// Both 14-bit halves are written, LSBs first, as expected when B28 is set
+static void appendFrequencyWrite(std::vector<uint8_t> &data, bool fsel, uint32_t code)
+{
+    data.push_back(static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & code >> 8)));
+    data.push_back(static_cast<uint8_t>(code));
+    data.push_back(static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & code >> 22)));
+    data.push_back(static_cast<uint8_t>(code >> 14));
+}
+
+// Appends the SPI words that write the given code to the PHASE0 or PHASE1 register of the AD9834, according to the boolean variable "psel"
+static void appendPhaseWrite(std::vector<uint8_t> &data, bool psel, uint16_t code)
+{
+    data.push_back(static_cast<uint8_t>((psel ? PHASE1 : PHASE0) | (0x0f & code >> 8)));
+    data.push_back(static_cast<uint8_t>(code));
+}
+
+// Encodes an SPI mode into a single byte, using the same layout as the CP2130 SPI word
+static uint8_t encodeSPIMode(const CP2130::SPIMode &mode)
+{
+    return static_cast<uint8_t>(mode.cpha << 5 | mode.cpol << 4 | mode.csmode << 3 | (0x07 & mode.cfrq));
+}
+
+// Decodes an SPI mode from a single byte (see above)
+static CP2130::SPIMode decodeSPIMode(uint8_t value)
+{
+    CP2130::SPIMode mode;
+    mode.csmode = (0x08 & value) != 0x00;
+    mode.cfrq = static_cast<uint8_t>(0x07 & value);
+    mode.cpol = (0x10 & value) != 0x00;
+    mode.cpha = (0x20 & value) != 0x00;
+    return mode;
+}
+
+// "Equal to" operator for Status
+bool GF2Device::Status::operator ==(const GF2Device::Status &other) const
+{
+    return clock == other.clock && dac == other.dac && waveGen == other.waveGen && fsel == other.fsel && psel == other.psel;
+}
+
+// "Not equal to" operator for Status
+bool GF2Device::Status::operator !=(const GF2Device::Status &other) const
+{
+    return !(operator ==(other));
+}
+
+// "Transaction" class constructor
+GF2Device::Transaction::Transaction(GF2Device &device) :
+    device_(device),
+    gpioValues_(0x0000),
+    gpioMask_(0x0000),
+    frequencyCodes_{0, 0},
+    frequencyPending_{false, false},
+    phaseCodes_{0, 0},
+    phasePending_{false, false},
+    amplitude_(0),
+    amplitudeCode_(0),
+    amplitudeResolved_(false),
+    amplitudePending_(false),
+    controlWord_(0x0000),
+    controlPending_(false),
+    restart_(false)
+{
+}
+
+// Private procedure used to set the value of a control line, superseding any value previously set in the same transaction
+void GF2Device::Transaction::setLine(uint16_t bitmap, bool value)
+{
+    gpioValues_ = static_cast<uint16_t>(value ? gpioValues_ | bitmap : gpioValues_ & ~bitmap);
+    gpioMask_ = static_cast<uint16_t>(gpioMask_ | bitmap);
+}
+
+// Returns true if there are no pending steps
+bool GF2Device::Transaction::isEmpty() const
+{
+    return gpioMask_ == 0x0000 && !frequencyPending_[0] && !frequencyPending_[1] && !phasePending_[0] && !phasePending_[1] && !amplitudePending_ && !controlPending_ && !restart_;
+}
+
+// Sends the pending steps to the device, and then discards them
+// If start() was called, the AD9834 waveform generator is held in reset while its registers are written, and released along with the other control lines
+// Each chip select is only enabled once, and the AD9834 and AD5310 writes are issued as one SPI transfer each
+void GF2Device::Transaction::commit(int &errcnt, std::string &errstr)
+{
+    CP2130 &cp2130 = device_.cp2130_;
+    std::vector<uint8_t> writeAD9834;
+    if (controlPending_) {
+        uint16_t controlWord = device_.controlKnown_ ? static_cast<uint16_t>((controlWord_ & ~(CTRLB28 | CTRLHLB)) | (device_.controlWord_ & (CTRLB28 | CTRLHLB))) : controlWord_;  // If possible, only the waveform is changed, so that a short frequency write that follows needs no further control word
+        device_.appendControlUpdate(writeAD9834, controlWord);  // The control word goes first, so that the register writes that follow are interpreted accordingly
+    }
+    for (int i = 0; i < 2; ++i) {
+        if (frequencyPending_[i]) {
+            device_.appendFrequencyUpdate(writeAD9834, i == 1, frequencyCodes_[i]);
+        }
+    }
+    for (int i = 0; i < 2; ++i) {
+        if (phasePending_[i]) {
+            appendPhaseWrite(writeAD9834, i == 1, phaseCodes_[i]);
+            device_.phaseCodes_[i] = phaseCodes_[i];
+            device_.phaseKnown_[i] = true;
+        }
+    }
+    int errcntSelection = 0;
+    if (amplitudePending_ && !amplitudeResolved_) {
+        bool fsel = false;
+        if ((CP2130::BMGPIO4 & gpioMask_) != 0x0000) {
+            fsel = (CP2130::BMGPIO4 & gpioValues_) != 0x0000;  // The frequency selection is set by this transaction
+        } else if (device_.linearization_.isFrequencyDependent()) {
+            fsel = device_.getFrequencySelection(errcntSelection, errstr);  // The active frequency is only needed if the amplitude linearization depends on it
+        }
+        amplitudeCode_ = device_.amplitudeCode(amplitude_, fsel);  // The frequency writes above were already accounted for
+        errcnt += errcntSelection;
+    }
+    std::vector<uint8_t> writeAD5310;
+    if (amplitudePending_ && errcntSelection == 0) {  // The amplitude is not set if the active frequency could not be determined
+        appendAmplitudeWrite(writeAD5310, amplitudeCode_);
+        device_.amplitudeCode_ = amplitudeCode_;
+        device_.amplitudeKnown_ = true;
+    }
+    if (restart_) {
+        cp2130.setGPIOs(CP2130::BMGPIO2, CP2130::BMGPIO2, errcnt, errstr);  // Disable and reset the AD9834 (GPIO.2 corresponds to the RST signal)
+    }
+    if (!writeAD9834.empty()) {
+        cp2130.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
+        usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
+        int errcntWrite = 0;
+        cp2130.spiWrite(writeAD9834, EPOUT, errcntWrite, errstr);  // Write all the pending AD9834 registers at once (channel 0)
+        if (errcntWrite > 0) {
+            errcnt += errcntWrite;
+            device_.invalidateRegisterCache();  // The registers may not hold what was meant to be written
+        }
+        usleep(100);  // Wait 100us, in order to prevent possible errors while switching or disabling the chip select (workaround)
+    }
+    if (!writeAD5310.empty()) {
+        cp2130.selectCS(1, errcnt, errstr);  // Enable the chip select corresponding to channel 1, and disable any others (this also disables the chip select corresponding to channel 0, if enabled)
+        usleep(100);  // Wait 100us, in order to prevent possible errors after switching the chip select (workaround implemented in version 1.0.1)
+        int errcntWrite = 0;
+        cp2130.spiWrite(writeAD5310, EPOUT, errcntWrite, errstr);  // Set the amplitude of the output signal (AD5310 on channel 1)
+        if (errcntWrite > 0) {
+            errcnt += errcntWrite;
+            device_.invalidateRegisterCache();
+        }
+        usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
+        cp2130.disableCS(1, errcnt, errstr);  // Disable the chip select corresponding to channel 1, which is the only one that is active to this point
+    } else if (!writeAD9834.empty()) {
+        cp2130.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
+    }
+    if (gpioMask_ != 0x0000) {
+        int errcntGPIOs = 0;
+        cp2130.setGPIOs(gpioValues_, gpioMask_, errcntGPIOs, errstr);  // Update all the affected control lines at once
+        errcnt += errcntGPIOs;
+        if ((CP2130::BMGPIO4 & gpioMask_) != 0x0000) {
+            device_.fsel_ = (CP2130::BMGPIO4 & gpioValues_) != 0x0000;
+            device_.fselKnown_ = errcntGPIOs == 0;
+        }
+        if ((CP2130::BMGPIO5 & gpioMask_) != 0x0000) {
+            device_.psel_ = (CP2130::BMGPIO5 & gpioValues_) != 0x0000;
+            device_.pselKnown_ = errcntGPIOs == 0;
+        }
+    }
+    discard();
+}
+
+// Discards all pending steps
+void GF2Device::Transaction::discard()
+{
+    gpioValues_ = 0x0000;
+    gpioMask_ = 0x0000;
+    frequencyPending_[0] = false;
+    frequencyPending_[1] = false;
+    phasePending_[0] = false;
+    phasePending_[1] = false;
+    amplitudePending_ = false;
+    controlPending_ = false;
+    restart_ = false;
+}
+
+// Appends a step that selects the active frequency
+void GF2Device::Transaction::selectFrequency(bool fsel)
+{
+    setLine(CP2130::BMGPIO4, fsel);  // GPIO.4 corresponds to the FSEL signal
+}
+
+// Appends a step that selects the active phase
+void GF2Device::Transaction::selectPhase(bool psel)
+{
+    setLine(CP2130::BMGPIO5, psel);  // GPIO.5 corresponds to the PSEL signal
+}
+
+// Appends a step that sets the amplitude of the generated signal to the given value (in Vpp)
+// If the amplitude linearization depends on the frequency, the frequency that is active after the commit applies
+void GF2Device::Transaction::setAmplitude(float amplitude, int &errcnt, std::string &errstr)
+{
+    if (amplitude < AMPLITUDE_MIN || amplitude > AMPLITUDE_MAX) {
+        ++errcnt;
+        errstr += "In setAmplitude(): Amplitude must be between 0 and 8.\n";  // Program logic error
+    } else {
+        amplitude_ = amplitude;
+        amplitudeResolved_ = false;
+        amplitudePending_ = true;
+    }
+}
+
+// Appends a step that enables or disables the synchronous clock
+void GF2Device::Transaction::setClockEnabled(bool value)
+{
+    setLine(CP2130::BMGPIO6, !value);  // GPIO.6 corresponds to the !CMPEN signal
+}
+
+// Appends a step that enables or disables the DAC internal to the AD9834 waveform generator
+void GF2Device::Transaction::setDACEnabled(bool value)
+{
+    setLine(CP2130::BMGPIO3, !value);  // GPIO.3 corresponds to the SLP signal
+}
+
+// Appends a step that sets the frequency, selected by the boolean variable "fsel", to the given value (in KHz)
+void GF2Device::Transaction::setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr)
+{
+    if (frequency < FREQUENCY_MIN || frequency > FREQUENCY_MAX) {
+        ++errcnt;
+        errstr += "In setFrequency(): Frequency must be between 0 and 40000.\n";  // Program logic error
+    } else {
+        frequencyCodes_[fsel] = device_.calibration_.frequencyCode(frequency);
+        frequencyPending_[fsel] = true;
+    }
+}
+
+// Appends a step that sets the phase, selected by the boolean variable "psel", to the given value (in degrees)
+void GF2Device::Transaction::setPhase(bool psel, float phase)
+{
+    phaseCodes_[psel] = phaseCode(phase);
+    phasePending_[psel] = true;
+}
+
+// Appends a step that sets the waveform of the generated signal to sinusoidal
+void GF2Device::Transaction::setSineWave()
+{
+    controlWord_ = 0x2200;  // B28 = 1, PIN/SW = 1, MODE = 0 (sinusoidal waveform)
+    controlPending_ = true;
+}
+
+// Appends a step that sets the waveform of the generated signal to triangular
+void GF2Device::Transaction::setTriangleWave()
+{
+    controlWord_ = 0x2202;  // B28 = 1, PIN/SW = 1, MODE = 1 (triangular waveform)
+    controlPending_ = true;
+}
+
+// Appends a step that enables or disables the AD9834 waveform generator
+void GF2Device::Transaction::setWaveGenEnabled(bool value)
+{
+    setLine(CP2130::BMGPIO2, !value);  // GPIO.2 corresponds to the RST signal
+}
+
+// Appends a step that starts (or restarts) the waveform generation
+void GF2Device::Transaction::start()
+{
+    restart_ = true;
+    setLine(CP2130::BMGPIO2, false);  // The AD9834 is re-enabled at the end of the commit
+}
+
+// Private function used to convert the given amplitude (in Vpp) into a DAC code, linearized for the frequency held by the FREQ0 or FREQ1 register, according to the boolean variable "fsel"
+// If that frequency is not known, the lowest frequency band applies
+uint16_t GF2Device::amplitudeCode(float amplitude, bool fsel) const
+{
+    return linearization_.amplitudeCode(amplitude, frequencyKnown_[fsel] ? frequencyCodes_[fsel] * MCLK / FQUANTUM : 0);  // The nominal master clock is accurate enough for selecting the band
+}
+
+// Private procedure used to append a write of the given control word to the AD9834 waveform generator, unless that word is already in place
+void GF2Device::appendControlUpdate(std::vector<uint8_t> &data, uint16_t controlWord)
+{
+    if (!controlKnown_ || controlWord != controlWord_) {
+        data.push_back(static_cast<uint8_t>(controlWord >> 8));
+        data.push_back(static_cast<uint8_t>(controlWord));
+        controlWord_ = controlWord;
+        controlKnown_ = true;
+    }
+}
+
+// Private procedure used to append a write of the given tuning word to the FREQ0 or FREQ1 register, according to the boolean variable "fsel" (added in version 1.1.0)
+// If the last tuning word written to that register is known and only one of its 14-bit halves changes, only that half is written, with B28 cleared
+// This requires the waveform to be known, since it is part of the same control word, so the full write is used until clear(), setSineWave() or setTriangleWave() is called
+// Until then, the control word is left untouched and B28 is assumed to be set, as close() leaves it (see setFrequency())
+void GF2Device::appendFrequencyUpdate(std::vector<uint8_t> &data, bool fsel, uint32_t code)
+{
+    bool shortWrite = controlKnown_ && frequencyKnown_[fsel];
+    if (shortWrite && (code ^ frequencyCodes_[fsel]) >> 14 == 0) {  // Only the LSBs change (or none)
+        appendControlUpdate(data, static_cast<uint16_t>(controlWord_ & ~(CTRLB28 | CTRLHLB)));
+        data.push_back(static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & code >> 8)));
+        data.push_back(static_cast<uint8_t>(code));
+    } else if (shortWrite && (0x3fff & (code ^ frequencyCodes_[fsel])) == 0) {  // Only the MSBs change
+        appendControlUpdate(data, static_cast<uint16_t>((controlWord_ & ~CTRLB28) | CTRLHLB));
+        data.push_back(static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & code >> 22)));
+        data.push_back(static_cast<uint8_t>(code >> 14));
+    } else {
+        if (controlKnown_) {
+            appendControlUpdate(data, static_cast<uint16_t>((controlWord_ & ~CTRLHLB) | CTRLB28));  // B28 is set again, in case a short write cleared it
+        }
+        appendFrequencyWrite(data, fsel, code);
+    }
+    frequencyCodes_[fsel] = code;
+    frequencyKnown_[fsel] = true;
+}
+
+// Private procedure used to forget the contents of the AD9834 and AD5310 registers, along with the states of the FSEL and PSEL signals, if these can no longer be trusted
+void GF2Device::invalidateRegisterCache()
+{
+    controlKnown_ = false;
+    frequencyKnown_[0] = false;
+    frequencyKnown_[1] = false;
+    phaseKnown_[0] = false;
+    phaseKnown_[1] = false;
+    amplitudeKnown_ = false;
+    fselKnown_ = false;
+    pselKnown_ = false;
+}
+
 GF2Device::GF2Device() :
-    cp2130_()
+    cp2130_(),
+    calibration_(),
+    linearization_(),
+    controlWord_(0x0000),
+    controlKnown_(false),
+    frequencyCodes_{{0}, {0}},
+    frequencyKnown_{{false}, {false}},
+    phaseCodes_{{0}, {0}},
+    phaseKnown_{{false}, {false}},
+    amplitudeCode_(0),
+    amplitudeKnown_(false),
+    fsel_(false),
+    psel_(false),
+    fselKnown_(false),
+    pselKnown_(false)
 {
 }
 
@@ -54,6 +411,60 @@ bool GF2Device::disconnected() const
     return cp2130_.disconnected();
 }
 
+// Returns the most recent USB transfers made to the device, as kept by the flight recorder of the CP2130, in a human readable format (added in version 1.1.0)
+// This is also valid after the device has been disconnected or closed, which makes it useful for post mortem diagnostics
+std::string GF2Device::dumpRecentOperations() const
+{
+    return cp2130_.dumpRecentOperations();
+}
+
+// Returns the frequency calibration in use (added in version 1.1.0)
+GF2Calibration GF2Device::getCalibration() const
+{
+    return calibration_;
+}
+
+// Returns the amplitude linearization in use (added in version 1.1.0)
+GF2Linearization GF2Device::getLinearization() const
+{
+    return linearization_;
+}
+
+// Returns the most recent USB transfers made to the device, from the oldest to the most recent (added in version 1.1.0)
+std::vector<CP2130::OperationRecord> GF2Device::getRecentOperations() const
+{
+    return cp2130_.getRecentOperations();
+}
+
+// Returns the last known state of the generator, without making any transfers (added in version 1.1.0)
+// This function can be called from any thread (e.g., by GF2Metrics), and it only reports what was written or set since the device was opened
+// Frequencies assume the nominal master clock, as expectedFrequency() does, and the amplitude is given as a DAC code, since the amplitude linearization is not inverted
+GF2Device::RegisterState GF2Device::getRegisterState() const
+{
+    RegisterState state;
+    for (size_t i = 0; i < 2; ++i) {
+        state.frequencyKnown[i] = frequencyKnown_[i];
+        state.frequencies[i] = static_cast<float>(frequencyCodes_[i] * static_cast<double>(MCLK) / FQUANTUM);
+        state.phaseKnown[i] = phaseKnown_[i];
+        state.phases[i] = static_cast<float>(phaseCodes_[i] * 360.0 / PQUANTUM);
+    }
+    state.amplitudeKnown = amplitudeKnown_;
+    state.amplitudeCode = amplitudeCode_;
+    state.waveformKnown = controlKnown_;
+    state.triangle = (0x0002 & controlWord_) != 0x0000;  // MODE bit of the control word
+    state.fselKnown = fselKnown_;
+    state.fsel = fsel_;
+    state.pselKnown = pselKnown_;
+    state.psel = psel_;
+    return state;
+}
+
+// Returns the transfer statistics of the device (see GF2Metrics for a way to export these - added in version 1.1.0)
+CP2130::Statistics GF2Device::getStatistics() const
+{
+    return cp2130_.getStatistics();
+}
+
 // Checks if the device is open
 bool GF2Device::isOpen() const
 {
@@ -63,6 +474,7 @@ bool GF2Device::isOpen() const
 // Sets the frequency, phase and amplitude of the generated signal to zero, and sets its waveform to sinusoidal
 void GF2Device::clear(int &errcnt, std::string &errstr)
 {
+    int preverrcnt = errcnt;
     setWaveGenEnabled(true, errcnt, errstr);  // This ensures that the RST signal is low prior to resetting the AD9834 waveform generator, since it requires an high to low transition on its RESET pin for the reset to be sampled and acknowledged
     cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
     usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
@@ -79,6 +491,16 @@ void GF2Device::clear(int &errcnt, std::string &errstr)
         PHASE1, 0x00               // PHASE1 register set to zero
     };
     cp2130_.spiWrite(clearAD9834, EPOUT, errcnt, errstr);  // Clear all of the AD9834 frequency and phase registers in order to set both generation parameters to zero
+    controlWord_ = 0x2200;
+    controlKnown_ = true;
+    frequencyCodes_[0] = 0;
+    frequencyCodes_[1] = 0;
+    frequencyKnown_[0] = true;
+    frequencyKnown_[1] = true;
+    phaseCodes_[0] = 0;
+    phaseCodes_[1] = 0;
+    phaseKnown_[0] = true;
+    phaseKnown_[1] = true;
     usleep(100);  // Wait 100us, in order to prevent possible errors while switching the chip select (workaround)
     cp2130_.selectCS(1, errcnt, errstr);  // Enable the chip select corresponding to channel 1, and disable the one corresponding to channel 0 (the previously selected channel)
     usleep(100);  // Wait 100us, in order to prevent possible errors after switching the chip select (workaround implemented in version 1.0.1)
@@ -86,6 +508,8 @@ void GF2Device::clear(int &errcnt, std::string &errstr)
         0x00, 0x00  // AD5310 register set to zero
     };
     cp2130_.spiWrite(clearAD5310, EPOUT, errcnt, errstr);  // Clear the AD5310 register in order to set the amplitude to zero
+    amplitudeCode_ = 0;
+    amplitudeKnown_ = true;
     usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
     cp2130_.disableCS(1, errcnt, errstr);  // Disable the chip select corresponding to channel 1, which is the only one that is active to this point
     setDACEnabled(true, errcnt, errstr);  // Enable the DAC that is internal to the AD9834
@@ -93,11 +517,28 @@ void GF2Device::clear(int &errcnt, std::string &errstr)
     selectPhase(PSEL0, errcnt, errstr);  // The PHASE0 register defines the phase of the AD9834
     setClockEnabled(true, errcnt, errstr);  // Enable the synchronous clock
     setWaveGenEnabled(true, errcnt, errstr);  // Re-enable the AD9834
+    if (errcnt > preverrcnt) {
+        invalidateRegisterCache();  // The registers may not have been cleared
+    }
 }
 
 // Closes the device safely, if open
 void GF2Device::close()
 {
+    if (controlKnown_ && (CTRLB28 & controlWord_) == 0x0000 && cp2130_.isOpen() && !cp2130_.disconnected()) {  // B28 is set again before closing, so that full tuning words can be safely written by a later session (added in version 1.1.0)
+        int errcnt = 0;
+        std::string errstr;
+        cp2130_.selectCS(0, errcnt, errstr);
+        usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
+        std::vector<uint8_t> setB28 = {
+            static_cast<uint8_t>((CTRLB28 | controlWord_) >> 8),
+            static_cast<uint8_t>(controlWord_)
+        };
+        cp2130_.spiWrite(setB28, EPOUT, errcnt, errstr);  // Any errors are ignored, since the device is being closed anyway
+        usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
+        cp2130_.disableCS(0, errcnt, errstr);
+    }
+    invalidateRegisterCache();
     cp2130_.close();
 }
 
@@ -143,6 +584,20 @@ std::u16string GF2Device::getSerialDesc(int &errcnt, std::string &errstr)
     return cp2130_.getSerialDesc(errcnt, errstr);
 }
 
+// Returns the state of all control lines, which are read by a single transfer (added in version 1.1.0)
+// This is equivalent to calling isClockEnabled(), isDACEnabled(), isWaveGenEnabled(), getFrequencySelection() and getPhaseSelection(), but takes one round trip instead of five
+GF2Device::Status GF2Device::getStatus(int &errcnt, std::string &errstr)
+{
+    uint16_t gpios = cp2130_.getGPIOs(errcnt, errstr);
+    Status status;
+    status.clock = (CP2130::BMGPIO6 & gpios) == 0x0000;    // GPIO.6 corresponds to the !CMPEN signal (SHDN pin on the TLV3501 comparator)
+    status.dac = (CP2130::BMGPIO3 & gpios) == 0x0000;      // GPIO.3 corresponds to the SLP signal (SLEEP pin on the AD9834 waveform generator)
+    status.waveGen = (CP2130::BMGPIO2 & gpios) == 0x0000;  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
+    status.fsel = (CP2130::BMGPIO4 & gpios) != 0x0000;     // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+    status.psel = (CP2130::BMGPIO5 & gpios) != 0x0000;     // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+    return status;
+}
+
 // Gets the USB configuration of the device
 CP2130::USBConfig GF2Device::getUSBConfig(int &errcnt, std::string &errstr)
 {
@@ -167,50 +622,249 @@ bool GF2Device::isWaveGenEnabled(int &errcnt, std::string &errstr)
     return !cp2130_.getGPIO2(errcnt, errstr);  // GPIO.2 corresponds to the RST signal (RESET pin on the AD9834 waveform generator)
 }
 
+// Estimates the frequency of the generated signal (in KHz) by counting its rising edges on GPIO.4 during the given gate time (in ms) (added in version 1.1.0)
+// This requires a board where the signal, divided by "divider", can be routed to GPIO.4, which otherwise drives the FSEL signal
+// The counter is cleared and read by a single transfer each, and GPIO.4 is restored as an output afterwards, keeping the frequency selection
+// The gate is timed from the middle of the first transfer to the middle of the second, which compensates for the USB latency on average
+float GF2Device::measureFrequency(uint16_t gate, uint16_t divider, int &errcnt, std::string &errstr)
+{
+    float retval = 0;
+    if (gate < GATE_MIN || gate > GATE_MAX) {
+        ++errcnt;
+        errstr += "In measureFrequency(): Gate time must be between 1 and 10000.\n";  // Program logic error
+    } else if (divider == 0) {
+        ++errcnt;
+        errstr += "In measureFrequency(): Divider must be greater than zero.\n";  // Program logic error
+    } else {
+        int errcntMeasure = 0;
+        bool fsel = getFrequencySelection(errcntMeasure, errstr);
+        if (errcntMeasure > 0) {
+            errcnt += errcntMeasure;  // GPIO.4 is left untouched, since its state as the FSEL output could not be saved
+        } else {
+            CP2130::EventCounter evtcntr;
+            evtcntr.overflow = false;
+            evtcntr.mode = CP2130::PCEVTCNTRRE;  // Count rising edges
+            evtcntr.value = 0;
+            std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+            cp2130_.setEventCounter(evtcntr, errcntMeasure, errstr);  // Switch GPIO.4 to the event counter mode and clear the count, at once
+            std::chrono::steady_clock::time_point start = before + (std::chrono::steady_clock::now() - before) / 2;
+            std::this_thread::sleep_for(std::chrono::milliseconds(gate));  // Unlike usleep(), this is not limited to one second
+            before = std::chrono::steady_clock::now();
+            evtcntr = cp2130_.getEventCounter(errcntMeasure, errstr);
+            std::chrono::steady_clock::time_point end = before + (std::chrono::steady_clock::now() - before) / 2;
+            cp2130_.configureGPIO(4, CP2130::PCOUTPP, fsel, errcntMeasure, errstr);  // Restore GPIO.4 as the FSEL output
+            fsel_ = fsel;
+            fselKnown_ = errcntMeasure == 0;  // GPIO.4 may have been left as an input
+            if (errcntMeasure > 0) {
+                errcnt += errcntMeasure;
+            } else if (evtcntr.overflow) {
+                ++errcnt;
+                errstr += "In measureFrequency(): Event counter overflowed, a shorter gate time or a larger divider is required.\n";
+            } else {
+                retval = static_cast<float>(static_cast<double>(evtcntr.value) * divider / std::chrono::duration<double, std::milli>(end - start).count());
+            }
+        }
+    }
+    return retval;
+}
+
 // Opens a device and assigns its handle
 int GF2Device::open(const std::string &serial)
 {
+    invalidateRegisterCache();
     return cp2130_.open(VID, PID, serial);
 }
 
+// Opens a device previously returned by enumerateDevices(), without scanning the bus again, and assigns its handle (added in version 1.1.0)
+int GF2Device::open(const CP2130::DeviceInfo &device)
+{
+    invalidateRegisterCache();
+    return cp2130_.open(VID, PID, device);
+}
+
+// Opens the device located at the given bus number and port path, and assigns its handle (added in version 1.1.0)
+int GF2Device::open(uint8_t bus, const std::vector<uint8_t> &ports)
+{
+    invalidateRegisterCache();
+    return cp2130_.open(VID, PID, bus, ports);
+}
+
+// Attaches an alternative transport, such as a CP2130Sim simulated device, instead of opening a real device (added in version 1.1.0)
+int GF2Device::open(CP2130Transport *transport)
+{
+    invalidateRegisterCache();
+    return cp2130_.open(transport);
+}
+
 // Issues a reset to the CP2130, which in effect resets the entire device
 void GF2Device::reset(int &errcnt, std::string &errstr)
 {
+    invalidateRegisterCache();
     cp2130_.reset(errcnt, errstr);
 }
 
+// Restores a profile previously returned by saveProfile() (added in version 1.1.0)
+// Registers already holding the values in the profile are not written again, and everything else is written by a single transaction
+// The SPI modes of both channels are also restored, which makes a prior call to setupChannel0() and setupChannel1() unnecessary
+void GF2Device::restoreProfile(const std::vector<uint8_t> &profile, int &errcnt, std::string &errstr)
+{
+    bool valid = profile.size() == PROFILE_SIZE && profile[0] == PROFILE_MAGIC[0] && profile[1] == PROFILE_MAGIC[1] && profile[2] == PROFILE_VERSION && profile[3] <= 0x01;
+    uint32_t frequencyCodes[2];
+    uint16_t phaseCodes[2];
+    for (size_t i = 0; valid && i < 2; ++i) {
+        frequencyCodes[i] = static_cast<uint32_t>(profile[4 * i + 7]) << 24 | static_cast<uint32_t>(profile[4 * i + 6]) << 16 | static_cast<uint32_t>(profile[4 * i + 5]) << 8 | profile[4 * i + 4];  // Little-endian conversion
+        phaseCodes[i] = static_cast<uint16_t>(profile[2 * i + 13] << 8 | profile[2 * i + 12]);
+        valid = frequencyCodes[i] < FQUANTUM && phaseCodes[i] < PQUANTUM;
+    }
+    uint16_t amplitudeCode = valid ? static_cast<uint16_t>(profile[17] << 8 | profile[16]) : 0;
+    uint16_t gpios = valid ? static_cast<uint16_t>(profile[19] << 8 | profile[18]) : 0;
+    if (!valid || amplitudeCode > AQUANTUM || (gpios & ~BMLINES) != 0x0000 || (0xc0 & (profile[20] | profile[21])) != 0x00) {
+        ++errcnt;
+        errstr += "In restoreProfile(): Invalid profile.\n";  // Program logic error
+    } else {
+        cp2130_.configureSPIMode(0, decodeSPIMode(profile[20]), errcnt, errstr);
+        cp2130_.configureSPIMode(1, decodeSPIMode(profile[21]), errcnt, errstr);
+        Transaction transaction(*this);
+        transaction.controlWord_ = profile[3] == 0x01 ? 0x2202 : 0x2200;  // The transaction only writes the control word if the waveform changes
+        transaction.controlPending_ = true;
+        for (size_t i = 0; i < 2; ++i) {
+            transaction.frequencyCodes_[i] = frequencyCodes[i];
+            transaction.frequencyPending_[i] = !frequencyKnown_[i] || frequencyCodes_[i] != frequencyCodes[i];
+            transaction.phaseCodes_[i] = phaseCodes[i];
+            transaction.phasePending_[i] = !phaseKnown_[i] || phaseCodes_[i] != phaseCodes[i];
+        }
+        transaction.amplitudeCode_ = amplitudeCode;
+        transaction.amplitudeResolved_ = true;
+        transaction.amplitudePending_ = !amplitudeKnown_ || amplitudeCode_ != amplitudeCode;
+        transaction.gpioValues_ = gpios;
+        transaction.gpioMask_ = BMLINES;
+        transaction.commit(errcnt, errstr);
+    }
+}
+
+// Returns a profile of "PROFILE_SIZE" [22] bytes, holding the state of the device, which can be restored later by restoreProfile() (added in version 1.1.0)
+// The profile holds the tuning words, phase codes, amplitude code, waveform, control lines and SPI modes of both channels
+// Since the registers of the AD9834 waveform generator and AD5310 DAC cannot be read, all of them must have been written since the device was opened (e.g., by clear())
+std::vector<uint8_t> GF2Device::saveProfile(int &errcnt, std::string &errstr)
+{
+    std::vector<uint8_t> profile;
+    if (!controlKnown_ || !frequencyKnown_[0] || !frequencyKnown_[1] || !phaseKnown_[0] || !phaseKnown_[1] || !amplitudeKnown_) {
+        ++errcnt;
+        errstr += "In saveProfile(): Not all registers were written since the device was opened.\n";  // Program logic error
+    } else {
+        int errcntRead = 0;
+        uint16_t gpios = static_cast<uint16_t>(BMLINES & cp2130_.getGPIOs(errcntRead, errstr));
+        CP2130::SPIMode mode0 = cp2130_.getSPIMode(0, errcntRead, errstr);
+        CP2130::SPIMode mode1 = cp2130_.getSPIMode(1, errcntRead, errstr);
+        if (errcntRead > 0) {
+            errcnt += errcntRead;
+        } else {
+            profile = {
+                PROFILE_MAGIC[0], PROFILE_MAGIC[1], PROFILE_VERSION,
+                static_cast<uint8_t>((0x0002 & controlWord_) == 0x0000 ? 0x00 : 0x01)  // Waveform (MODE bit of the control word)
+            };
+            for (size_t i = 0; i < 2; ++i) {  // Tuning words, in little-endian byte order
+                profile.push_back(static_cast<uint8_t>(frequencyCodes_[i]));
+                profile.push_back(static_cast<uint8_t>(frequencyCodes_[i] >> 8));
+                profile.push_back(static_cast<uint8_t>(frequencyCodes_[i] >> 16));
+                profile.push_back(static_cast<uint8_t>(frequencyCodes_[i] >> 24));
+            }
+            for (size_t i = 0; i < 2; ++i) {  // Phase codes
+                profile.push_back(static_cast<uint8_t>(phaseCodes_[i]));
+                profile.push_back(static_cast<uint8_t>(phaseCodes_[i] >> 8));
+            }
+            profile.push_back(static_cast<uint8_t>(amplitudeCode_));
+            profile.push_back(static_cast<uint8_t>(amplitudeCode_ >> 8));
+            profile.push_back(static_cast<uint8_t>(gpios));
+            profile.push_back(static_cast<uint8_t>(gpios >> 8));
+            profile.push_back(encodeSPIMode(mode0));
+            profile.push_back(encodeSPIMode(mode1));
+        }
+    }
+    return profile;
+}
+
 // Selects the active frequency
 void GF2Device::selectFrequency(bool fsel, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO4(fsel, errcnt, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+    int errcntWrite = 0;
+    cp2130_.setGPIO4(fsel, errcntWrite, errstr);  // GPIO.4 corresponds to the FSEL signal (FSELECT pin on the AD9834 waveform generator)
+    errcnt += errcntWrite;
+    fsel_ = fsel;
+    fselKnown_ = errcntWrite == 0;
 }
 
 // Selects the active phase
 void GF2Device::selectPhase(bool psel, int &errcnt, std::string &errstr)
 {
-    cp2130_.setGPIO5(psel, errcnt, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+    int errcntWrite = 0;
+    cp2130_.setGPIO5(psel, errcntWrite, errstr);  // GPIO.5 corresponds to the PSEL signal (PSELECT pin on the AD9834 waveform generator)
+    errcnt += errcntWrite;
+    psel_ = psel;
+    pselKnown_ = errcntWrite == 0;
 }
 
 // Sets the amplitude of the generated signal to the given value (in Vpp)
+// If the amplitude linearization depends on the frequency, the frequency last written to the active FREQ register applies (see the overload below)
 void GF2Device::setAmplitude(float amplitude, int &errcnt, std::string &errstr)
 {
     if (amplitude < AMPLITUDE_MIN || amplitude > AMPLITUDE_MAX) {
         ++errcnt;
         errstr += "In setAmplitude(): Amplitude must be between 0 and 8.\n";  // Program logic error
+    } else {
+        bool fsel = false;
+        int errcntSelection = 0;
+        if (linearization_.isFrequencyDependent()) {
+            fsel = getFrequencySelection(errcntSelection, errstr);  // The active frequency is only needed if the amplitude linearization depends on it
+        }
+        if (errcntSelection > 0) {
+            errcnt += errcntSelection;
+        } else {
+            setAmplitudeCode(amplitudeCode(amplitude, fsel), errcnt, errstr);
+        }
+    }
+}
+
+// Sets the amplitude of the generated signal to the given value (in Vpp), linearized for the given frequency (in KHz) (added in version 1.1.0)
+void GF2Device::setAmplitude(float amplitude, float frequency, int &errcnt, std::string &errstr)
+{
+    if (amplitude < AMPLITUDE_MIN || amplitude > AMPLITUDE_MAX) {
+        ++errcnt;
+        errstr += "In setAmplitude(): Amplitude must be between 0 and 8.\n";  // Program logic error
+    } else {
+        setAmplitudeCode(linearization_.amplitudeCode(amplitude, frequency), errcnt, errstr);
+    }
+}
+
+// Sets the code of the AD5310 DAC directly, bypassing the amplitude conversion (added in version 1.1.0)
+// This is meant for envelopes, whose codes can be computed beforehand by GF2Linearization::amplitudeCodes()
+void GF2Device::setAmplitudeCode(uint16_t code, int &errcnt, std::string &errstr)
+{
+    if (code > GF2Linearization::CODE_MAX) {
+        ++errcnt;
+        errstr += "In setAmplitudeCode(): Code must be between 0 and 1023.\n";  // Program logic error
     } else {
         cp2130_.selectCS(1, errcnt, errstr);  // Enable the chip select corresponding to channel 1, and disable any others
         usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-        uint16_t amplitudeCode = static_cast<uint16_t>(amplitude * AQUANTUM / AMPLITUDE_MAX + 0.5);
-        std::vector<uint8_t> setAmplitude = {
-            static_cast<uint8_t>(0x0f & amplitudeCode >> 6),  // Amplitude
-            static_cast<uint8_t>(amplitudeCode << 2)
-        };
-        cp2130_.spiWrite(setAmplitude, EPOUT, errcnt, errstr);  // Set the amplitude of the output signal (AD5310 on channel 1)selectPhase
+        std::vector<uint8_t> setAmplitude;
+        appendAmplitudeWrite(setAmplitude, code);  // Amplitude
+        int errcntWrite = 0;
+        cp2130_.spiWrite(setAmplitude, EPOUT, errcntWrite, errstr);  // Set the amplitude of the output signal (AD5310 on channel 1)
+        errcnt += errcntWrite;
+        amplitudeCode_ = code;
+        amplitudeKnown_ = errcntWrite == 0;
         usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
         cp2130_.disableCS(1, errcnt, errstr);  // Disable the previously enabled chip select
     }
 }
 
+// Sets the frequency calibration to be applied by setFrequency(), setFrequencyAndPhase() and transactions (added in version 1.1.0)
+// Registers that were already written keep their tuning words until written again
+void GF2Device::setCalibration(const GF2Calibration &calibration)
+{
+    calibration_ = calibration;
+}
+
 // Enables or disables the synchronous clock
 void GF2Device::setClockEnabled(bool value, int &errcnt, std::string &errstr)
 {
@@ -224,6 +878,7 @@ void GF2Device::setDACEnabled(bool value, int &errcnt, std::string &errstr)
 }
 
 // Sets the frequency, selected by the boolean variable "fsel", to the given value (in KHz)
+// If a previous session ended without closing the device, B28 may have been left cleared, so clear(), setSineWave() or setTriangleWave() should be called first
 void GF2Device::setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr)
 {
     if (frequency < FREQUENCY_MIN || frequency > FREQUENCY_MAX) {
@@ -232,31 +887,63 @@ void GF2Device::setFrequency(bool fsel, float frequency, int &errcnt, std::strin
     } else {
         cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
         usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-        uint32_t frequencyCode = static_cast<uint32_t>(frequency * FQUANTUM / MCLK + 0.5);
-        std::vector<uint8_t> setFrequency = {
-            static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & frequencyCode >> 8)),   // FREQ0 or FREQ1 register set to the given value, according to the boolean variable "fsel"
-            static_cast<uint8_t>(frequencyCode),
-            static_cast<uint8_t>((fsel ? FREQ1 : FREQ0) | (0x3f & frequencyCode >> 22)),
-            static_cast<uint8_t>(frequencyCode >> 14)
-        };
-        cp2130_.spiWrite(setFrequency, EPOUT, errcnt, errstr);  // Set the selected frequency by updating the above registers (AD9834 on channel 0)
+        std::vector<uint8_t> setFrequency;
+        appendFrequencyUpdate(setFrequency, fsel, calibration_.frequencyCode(frequency));  // FREQ0 or FREQ1 register set to the given value, according to the boolean variable "fsel" (only the 14-bit half that changes is written, if possible)
+        int errcntWrite = 0;
+        cp2130_.spiWrite(setFrequency, EPOUT, errcntWrite, errstr);  // Set the selected frequency by updating the above registers (AD9834 on channel 0)
+        if (errcntWrite > 0) {
+            errcnt += errcntWrite;
+            invalidateRegisterCache();  // The registers may not hold what was meant to be written
+        }
         usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
         cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
     }
 }
 
+// Sets both the frequency (in KHz) and the phase (in degrees) of the generated signal at once, without passing through intermediate states (added in version 1.1.0)
+// The inactive FREQ and PHASE registers are written in a single SPI transfer, and only then are FSEL and PSEL switched over together
+void GF2Device::setFrequencyAndPhase(float frequency, float phase, int &errcnt, std::string &errstr)
+{
+    if (frequency < FREQUENCY_MIN || frequency > FREQUENCY_MAX) {
+        ++errcnt;
+        errstr += "In setFrequencyAndPhase(): Frequency must be between 0 and 40000.\n";  // Program logic error
+    } else {
+        int errcntGPIOs = 0;
+        uint16_t gpios = cp2130_.getGPIOs(errcntGPIOs, errstr);
+        if (errcntGPIOs > 0) {
+            errcnt += errcntGPIOs;  // Without knowing which registers are active, none can be safely written
+        } else {
+            bool fsel = (CP2130::BMGPIO4 & gpios) == 0x0000;  // The inactive frequency register (GPIO.4 corresponds to the FSEL signal)
+            bool psel = (CP2130::BMGPIO5 & gpios) == 0x0000;  // The inactive phase register (GPIO.5 corresponds to the PSEL signal)
+            Transaction transaction(*this);
+            transaction.setFrequency(fsel, frequency, errcnt, errstr);
+            transaction.setPhase(psel, phase);
+            transaction.selectFrequency(fsel);
+            transaction.selectPhase(psel);
+            transaction.commit(errcnt, errstr);  // The transaction writes the registers before updating the control lines
+        }
+    }
+}
+
+// Sets the amplitude linearization to be applied by setAmplitude() and transactions (added in version 1.1.0)
+void GF2Device::setLinearization(const GF2Linearization &linearization)
+{
+    linearization_ = linearization;
+}
+
 // Sets the phase, selected by the boolean variable "psel", to the given value (in degrees)
 void GF2Device::setPhase(bool psel, float phase, int &errcnt, std::string &errstr)
 {
     cp2130_.selectCS(0, errcnt, errstr);  // Enable the chip select corresponding to channel 0, and disable any others
     usleep(100);  // Wait 100us, in order to prevent possible errors after enabling the chip select (workaround implemented in version 1.0.1)
-    float phaseMod = std::fmod(phase, 360);  // Calculate the remainder of the division between the phase and 360
-    uint16_t phaseCode = static_cast<uint16_t>((phaseMod + (phaseMod < 0 ? 360 : 0)) * PQUANTUM / 360 + 0.5);
-    std::vector<uint8_t> setPhase = {
-        static_cast<uint8_t>((psel ? PHASE1 : PHASE0) | (0x0f & phaseCode >> 8)),   // PHASE0 or PHASE1 register set to the given value, according to the boolean variable "psel"
-        static_cast<uint8_t>(phaseCode)
-    };
-    cp2130_.spiWrite(setPhase, EPOUT, errcnt, errstr);  // Set the selected phase by updating the above registers (AD9834 on channel 0)
+    std::vector<uint8_t> setPhase;
+    uint16_t code = phaseCode(phase);
+    appendPhaseWrite(setPhase, psel, code);  // PHASE0 or PHASE1 register set to the given value, according to the boolean variable "psel"
+    int errcntWrite = 0;
+    cp2130_.spiWrite(setPhase, EPOUT, errcntWrite, errstr);  // Set the selected phase by updating the above registers (AD9834 on channel 0)
+    errcnt += errcntWrite;
+    phaseCodes_[psel] = code;
+    phaseKnown_[psel] = errcntWrite == 0;
     usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
     cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
 }
@@ -269,7 +956,15 @@ void GF2Device::setSineWave(int &errcnt, std::string &errstr)
     std::vector<uint8_t> setSineWave = {
         0x22, 0x00  // B28 = 1, PIN/SW = 1, MODE = 0 (sinusoidal waveform)
     };
-    cp2130_.spiWrite(setSineWave, EPOUT, errcnt, errstr);  // Set the waveform to sinusoidal (AD9834 on channel 0)
+    int errcntWrite = 0;
+    cp2130_.spiWrite(setSineWave, EPOUT, errcntWrite, errstr);  // Set the waveform to sinusoidal (AD9834 on channel 0)
+    if (errcntWrite > 0) {
+        errcnt += errcntWrite;
+        invalidateRegisterCache();  // The control register may not hold what was meant to be written
+    } else {
+        controlWord_ = 0x2200;
+        controlKnown_ = true;
+    }
     usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
     cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
 }
@@ -282,7 +977,15 @@ void GF2Device::setTriangleWave(int &errcnt, std::string &errstr)
     std::vector<uint8_t> setTriangleWave = {
         0x22, 0x02  // B28 = 1, PIN/SW = 1, MODE = 1 (triangular waveform)
     };
-    cp2130_.spiWrite(setTriangleWave, EPOUT, errcnt, errstr);  // Set the waveform to triangular (AD9834 on channel 0)
+    int errcntWrite = 0;
+    cp2130_.spiWrite(setTriangleWave, EPOUT, errcntWrite, errstr);  // Set the waveform to triangular (AD9834 on channel 0)
+    if (errcntWrite > 0) {
+        errcnt += errcntWrite;
+        invalidateRegisterCache();  // The control register may not hold what was meant to be written
+    } else {
+        controlWord_ = 0x2202;
+        controlKnown_ = true;
+    }
     usleep(100);  // Wait 100us, in order to prevent possible errors while disabling the chip select (workaround)
     cp2130_.disableCS(0, errcnt, errstr);  // Disable the previously enabled chip select
 }
@@ -335,6 +1038,12 @@ void GF2Device::stop(int &errcnt, std::string &errstr)
     }
 }
 
+// Helper function to enumerate devices, including their locations (and, optionally, their manufacturer and product strings - added in version 1.1.0)
+std::list<CP2130::DeviceInfo> GF2Device::enumerateDevices(bool strings, int &errcnt, std::string &errstr)
+{
+    return CP2130::enumerateDevices(VID, PID, strings, errcnt, errstr);
+}
+
 // Helper function that returns the expected amplitude from a given amplitude value
 // Note that the function is only valid for values between "AMPLITUDE_MIN" [0] and "AMPLITUDE_MAX" [8]
 float GF2Device::expectedAmplitude(float amplitude)
@@ -344,6 +1053,7 @@ float GF2Device::expectedAmplitude(float amplitude)
 
 // Helper function that returns the expected frequency from a given frequency value
 // Note that the function is only valid for values between "FREQUENCY_MIN" [0] and "FREQUENCY_MAX" [40000]
+// An ideal master clock is assumed, so GF2Calibration::expectedFrequency() should be used instead for calibrated devices
 float GF2Device::expectedFrequency(float frequency)
 {
     return std::round(frequency * FQUANTUM / MCLK) * MCLK / FQUANTUM;
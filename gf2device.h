@@ -1,5 +1,5 @@
-/* GF2 device class - Version 1.0.1
-   Requires CP2130 class version 1.1.0 or later
+/* GF2 device class - Version 1.1.0
+   Requires CP2130 class version 1.3.0 or later
    Copyright (c) 2022 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
@@ -23,15 +23,37 @@
 #define GF2DEVICE_H
 
 // Includes
+#include <atomic>
 #include <cstdint>
 #include <list>
 #include <string>
+#include <vector>
 #include "cp2130.h"
+#include "gf2calibration.h"
+#include "gf2linearization.h"
 
 class GF2Device
 {
 private:
     CP2130 cp2130_;
+    GF2Calibration calibration_;
+    GF2Linearization linearization_;
+    // The members below are atomic, so that getRegisterState() can be called from any thread
+    std::atomic<uint16_t> controlWord_;        // Last control word written to the AD9834 waveform generator, if known
+    std::atomic<bool> controlKnown_;
+    std::atomic<uint32_t> frequencyCodes_[2];  // Last tuning words written to the FREQ0 and FREQ1 registers, if known
+    std::atomic<bool> frequencyKnown_[2];
+    std::atomic<uint16_t> phaseCodes_[2];      // Last codes written to the PHASE0 and PHASE1 registers, if known
+    std::atomic<bool> phaseKnown_[2];
+    std::atomic<uint16_t> amplitudeCode_;      // Last code written to the AD5310 DAC, if known
+    std::atomic<bool> amplitudeKnown_;
+    std::atomic<bool> fsel_, psel_;            // Last states set to the FSEL and PSEL signals, if known
+    std::atomic<bool> fselKnown_, pselKnown_;
+
+    uint16_t amplitudeCode(float amplitude, bool fsel) const;
+    void appendControlUpdate(std::vector<uint8_t> &data, uint16_t controlWord);
+    void appendFrequencyUpdate(std::vector<uint8_t> &data, bool fsel, uint32_t code);
+    void invalidateRegisterCache();
 
 public:
     // Class definitions
@@ -50,6 +72,13 @@ public:
     static const bool FSEL0 = false;  // Boolean corresponding to frequency 0 selection
     static const bool FSEL1 = true;   // Boolean corresponding to frequency 1 selection
 
+    // Limits applicable to measureFrequency()
+    static const uint16_t GATE_MIN = 1;      // Minimum gate time
+    static const uint16_t GATE_MAX = 10000;  // Maximum gate time
+
+    // Size of the profiles returned by saveProfile()
+    static const size_t PROFILE_SIZE = 22;
+
     // Limits applicable to setFrequency()
     static constexpr float FREQUENCY_MIN = 0;      // Minimum frequency
     static constexpr float FREQUENCY_MAX = 40000;  // Maximum frequency
@@ -58,9 +87,89 @@ public:
     static const bool PSEL0 = false;  // Boolean corresponding to phase 0 selection
     static const bool PSEL1 = true;   // Boolean corresponding to phase 1 selection
 
+    // State of the control lines, as returned by getStatus() (added in version 1.1.0)
+    struct Status {
+        bool clock;    // True if the synchronous clock is enabled
+        bool dac;      // True if the DAC internal to the AD9834 waveform generator is enabled
+        bool waveGen;  // True if the AD9834 waveform generator is enabled
+        bool fsel;     // Current frequency selection
+        bool psel;     // Current phase selection
+
+        bool operator ==(const Status &other) const;
+        bool operator !=(const Status &other) const;
+    };
+
+    // Last known state of the generator, as returned by getRegisterState() (added in version 1.1.0)
+    // Each value is only meaningful if the corresponding "Known" member is true
+    struct RegisterState {
+        bool frequencyKnown[2];
+        float frequencies[2];    // Frequencies (in KHz) held by the FREQ0 and FREQ1 registers, assuming the nominal master clock
+        bool phaseKnown[2];
+        float phases[2];         // Phases (in degrees) held by the PHASE0 and PHASE1 registers
+        bool amplitudeKnown;
+        uint16_t amplitudeCode;  // Code held by the AD5310 DAC, which sets the amplitude (before any linearization is undone)
+        bool waveformKnown;
+        bool triangle;           // True if the waveform is triangular, or false if it is sinusoidal
+        bool fselKnown;
+        bool fsel;               // Current frequency selection
+        bool pselKnown;
+        bool psel;               // Current phase selection
+    };
+
+    // Sequence of high-level steps that is only sent to the device when committed (added in version 1.1.0)
+    // Only the last value written to each register or control line is kept, so that superseded writes never reach the bus
+    // On commit, GPIO updates are merged into a single transfer, and SPI writes are grouped by chip select
+    class Transaction
+    {
+    private:
+        GF2Device &device_;
+        uint16_t gpioValues_;
+        uint16_t gpioMask_;
+        uint32_t frequencyCodes_[2];
+        bool frequencyPending_[2];
+        uint16_t phaseCodes_[2];
+        bool phasePending_[2];
+        float amplitude_;
+        uint16_t amplitudeCode_;
+        bool amplitudeResolved_;  // True if "amplitudeCode_" is set directly, otherwise the code is obtained from "amplitude_" when committing
+        bool amplitudePending_;
+        uint16_t controlWord_;
+        bool controlPending_;
+        bool restart_;
+
+        void setLine(uint16_t bitmap, bool value);
+
+        friend class GF2Device;  // Allows restoreProfile() to set codes directly
+
+    public:
+        explicit Transaction(GF2Device &device);
+
+        bool isEmpty() const;
+
+        void commit(int &errcnt, std::string &errstr);
+        void discard();
+        void selectFrequency(bool fsel);
+        void selectPhase(bool psel);
+        void setAmplitude(float amplitude, int &errcnt, std::string &errstr);
+        void setClockEnabled(bool value);
+        void setDACEnabled(bool value);
+        void setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr);
+        void setPhase(bool psel, float phase);
+        void setSineWave();
+        void setTriangleWave();
+        void setWaveGenEnabled(bool value);
+        void start();
+    };
+
     GF2Device();
 
     bool disconnected() const;
+    std::string dumpRecentOperations() const;
+    GF2Calibration getCalibration() const;
+    GF2Linearization getLinearization() const;
+    std::vector<CP2130::OperationRecord> getRecentOperations() const;
+    RegisterState getRegisterState() const;
+    CP2130::Statistics getStatistics() const;
     bool isOpen() const;
 
     void clear(int &errcnt, std::string &errstr);
@@ -72,18 +181,30 @@ public:
     bool getPhaseSelection(int &errcnt, std::string &errstr);
     std::u16string getProductDesc(int &errcnt, std::string &errstr);
     std::u16string getSerialDesc(int &errcnt, std::string &errstr);
+    Status getStatus(int &errcnt, std::string &errstr);
     CP2130::USBConfig getUSBConfig(int &errcnt, std::string &errstr);
     bool isClockEnabled(int &errcnt, std::string &errstr);
     bool isDACEnabled(int &errcnt, std::string &errstr);
     bool isWaveGenEnabled(int &errcnt, std::string &errstr);
+    float measureFrequency(uint16_t gate, uint16_t divider, int &errcnt, std::string &errstr);
     int open(const std::string &serial = std::string());
+    int open(const CP2130::DeviceInfo &device);
+    int open(uint8_t bus, const std::vector<uint8_t> &ports);
+    int open(CP2130Transport *transport);
     void reset(int &errcnt, std::string &errstr);
+    void restoreProfile(const std::vector<uint8_t> &profile, int &errcnt, std::string &errstr);
+    std::vector<uint8_t> saveProfile(int &errcnt, std::string &errstr);
     void selectFrequency(bool fsel, int &errcnt, std::string &errstr);
     void selectPhase(bool psel, int &errcnt, std::string &errstr);
     void setAmplitude(float amplitude, int &errcnt, std::string &errstr);
+    void setAmplitude(float amplitude, float frequency, int &errcnt, std::string &errstr);
+    void setAmplitudeCode(uint16_t code, int &errcnt, std::string &errstr);
+    void setCalibration(const GF2Calibration &calibration);
     void setClockEnabled(bool value, int &errcnt, std::string &errstr);
     void setDACEnabled(bool value, int &errcnt, std::string &errstr);
     void setFrequency(bool fsel, float frequency, int &errcnt, std::string &errstr);
+    void setFrequencyAndPhase(float frequency, float phase, int &errcnt, std::string &errstr);
+    void setLinearization(const GF2Linearization &linearization);
     void setPhase(bool psel, float phase, int &errcnt, std::string &errstr);
     void setSineWave(int &errcnt, std::string &errstr);
     void setTriangleWave(int &errcnt, std::string &errstr);
@@ -93,6 +214,7 @@ public:
     void start(int &errcnt, std::string &errstr);
     void stop(int &errcnt, std::string &errstr);
 
+    static std::list<CP2130::DeviceInfo> enumerateDevices(bool strings, int &errcnt, std::string &errstr);
     static float expectedAmplitude(float amplitude);
     static float expectedFrequency(float frequency);
     static float expectedPhase(float phase);
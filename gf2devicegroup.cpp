@@ -0,0 +1,104 @@
+/* GF2 device group class - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <list>
+#include "gf2devicegroup.h"
+
+// "GF2DeviceGroup" class constructor
+GF2DeviceGroup::GF2DeviceGroup() :
+    devices_(),
+    serials_()
+{
+}
+
+// "GF2DeviceGroup" class destructor
+GF2DeviceGroup::~GF2DeviceGroup()
+{
+    close();
+}
+
+// Returns the serial number of the device at the given index (empty for simulated devices)
+std::string GF2DeviceGroup::getSerial(size_t index) const
+{
+    return serials_.at(index);
+}
+
+// Returns the number of devices in the group
+size_t GF2DeviceGroup::size() const
+{
+    return devices_.size();
+}
+
+// Opens the device having the given serial number and adds it to the group, if successful
+// Returns the same values as GF2Device::open()
+int GF2DeviceGroup::add(const std::string &serial)
+{
+    std::unique_ptr<GF2Device> device(new GF2Device);
+    int retval = device->open(serial);
+    if (retval == GF2Device::SUCCESS) {
+        devices_.push_back(std::move(device));
+        serials_.push_back(serial);
+    }
+    return retval;
+}
+
+// Attaches an alternative transport, such as a CP2130Sim simulated device, and adds it to the group, if successful
+int GF2DeviceGroup::add(CP2130Transport *transport)
+{
+    std::unique_ptr<GF2Device> device(new GF2Device);
+    int retval = device->open(transport);
+    if (retval == GF2Device::SUCCESS) {
+        devices_.push_back(std::move(device));
+        serials_.push_back(std::string());
+    }
+    return retval;
+}
+
+// Opens every GF2 device that is connected and adds it to the group
+// Devices that cannot be opened, such as those in use by another program, are reported but do not prevent the others from being added
+void GF2DeviceGroup::addAll(int &errcnt, std::string &errstr)
+{
+    std::list<std::string> serials = GF2Device::listDevices(errcnt, errstr);
+    for (const std::string &serial : serials) {
+        if (add(serial) != GF2Device::SUCCESS) {
+            ++errcnt;
+            errstr += "Could not open device \"" + serial + "\".\n";
+        }
+    }
+}
+
+// Closes all devices and removes them from the group
+void GF2DeviceGroup::close()
+{
+    for (std::unique_ptr<GF2Device> &device : devices_) {
+        device->close();
+    }
+    devices_.clear();
+    serials_.clear();
+}
+
+// Returns the device at the given index
+// Note that the index must be less than the value returned by size()
+GF2Device &GF2DeviceGroup::getDevice(size_t index)
+{
+    return *devices_.at(index);
+}
@@ -0,0 +1,54 @@
+/* GF2 device group class - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2DEVICEGROUP_H
+#define GF2DEVICEGROUP_H
+
+// Includes
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gf2device.h"
+
+// Set of GF2 devices that are used together, such as the boards of a test rig
+// Devices are owned by the group and identified by their index, which is the order in which they were added
+class GF2DeviceGroup
+{
+private:
+    std::vector<std::unique_ptr<GF2Device>> devices_;
+    std::vector<std::string> serials_;
+
+public:
+    GF2DeviceGroup();
+    ~GF2DeviceGroup();
+
+    std::string getSerial(size_t index) const;
+    size_t size() const;
+
+    int add(const std::string &serial);
+    int add(CP2130Transport *transport);
+    void addAll(int &errcnt, std::string &errstr);
+    void close();
+    GF2Device &getDevice(size_t index);
+};
+
+#endif  // GF2DEVICEGROUP_H
@@ -0,0 +1,229 @@
+/* GF2 executor class - Version 1.0.0
+   Requires GF2 device group class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include "gf2executor.h"
+
+// Executor and worker index of the calling thread, if it is a worker
+static thread_local const GF2Executor *currentExecutor = nullptr;
+static thread_local size_t currentWorker = 0;
+
+// "Equal to" operator for Statistics
+bool GF2Executor::Statistics::operator ==(const GF2Executor::Statistics &other) const
+{
+    return tasks == other.tasks && steals == other.steals;
+}
+
+// "Not equal to" operator for Statistics
+bool GF2Executor::Statistics::operator !=(const GF2Executor::Statistics &other) const
+{
+    return !(operator ==(other));
+}
+
+// Private procedure that runs the loop of the given worker, until the executor is destroyed
+// The device is released before the continuation runs, so that its next task can be taken by another worker in the meantime
+void GF2Executor::run(size_t worker)
+{
+    currentExecutor = this;
+    currentWorker = worker;
+    bool running = true;
+    while (running) {
+        size_t device;
+        if (take(worker, device)) {
+            Strand &strand = *strands_[device];
+            Job job;
+            {
+                std::lock_guard<std::mutex> lock(strand.mutex);
+                job = std::move(strand.jobs.front());
+                strand.jobs.pop_front();
+            }
+            int errcnt = 0;
+            std::string errstr;
+            job.task(group_.getDevice(device), errcnt, errstr);
+            bool pending;
+            {
+                std::lock_guard<std::mutex> lock(strand.mutex);
+                pending = !strand.jobs.empty();
+                strand.scheduled = pending;
+            }
+            if (pending) {
+                schedule(device);  // Goes to the back of the queue, so that the other devices of this worker get their turn
+            }
+            if (job.continuation) {
+                job.continuation(errcnt, errstr);
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++statistics_.tasks;
+            --outstanding_;
+            if (outstanding_ == 0) {
+                idle_.notify_all();
+            }
+        } else {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this]() { return queued_ > 0 || stopping_; });
+            running = queued_ > 0 || !stopping_;
+        }
+    }
+}
+
+// Private procedure used to queue a device that has tasks pending and is not scheduled yet
+// If called from a worker, such as from a continuation, the device goes to the queue of that worker
+void GF2Executor::schedule(size_t device)
+{
+    size_t queue;
+    if (currentExecutor == this) {
+        queue = currentWorker;
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue = next_;
+        next_ = (next_ + 1) % queues_.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[queue]->mutex);
+        queues_[queue]->devices.push_back(device);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++queued_;
+    ready_.notify_one();
+}
+
+// Private function that takes the next device from the queue of the given worker or, if that queue is empty, from the queue of another worker
+// Returns false if all queues are empty
+bool GF2Executor::take(size_t worker, size_t &device)
+{
+    bool retval = false;
+    bool stolen = false;
+    for (size_t i = 0; i < queues_.size() && !retval; ++i) {
+        Queue &queue = *queues_[(worker + i) % queues_.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.devices.empty()) {
+            device = queue.devices.front();
+            queue.devices.pop_front();
+            retval = true;
+            stolen = i > 0;
+        }
+    }
+    if (retval) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --queued_;
+        if (stolen) {
+            ++statistics_.steals;
+        }
+    }
+    return retval;
+}
+
+// "GF2Executor" class constructor
+// If the number of threads is zero, one thread per hardware thread is used
+GF2Executor::GF2Executor(GF2DeviceGroup &group, size_t threads) :
+    group_(group),
+    strands_(),
+    queues_(),
+    workers_(),
+    mutex_(),
+    ready_(),
+    idle_(),
+    queued_(0),
+    outstanding_(0),
+    next_(0),
+    stopping_(false),
+    statistics_{0, 0}
+{
+    if (threads == 0) {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    for (size_t i = 0; i < group_.size(); ++i) {
+        strands_.push_back(std::unique_ptr<Strand>(new Strand));
+        strands_.back()->scheduled = false;
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        queues_.push_back(std::unique_ptr<Queue>(new Queue));
+    }
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::thread([this, i]() { run(i); }));
+    }
+}
+
+// "GF2Executor" class destructor
+// Pending tasks, and any tasks that their continuations submit, are completed before the workers are stopped
+GF2Executor::~GF2Executor()
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (std::thread &worker : workers_) {
+        worker.join();
+    }
+}
+
+// Returns the statistics of the executor
+GF2Executor::Statistics GF2Executor::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+// Returns the number of worker threads
+size_t GF2Executor::getThreads() const
+{
+    return workers_.size();
+}
+
+// Submits a task bound to the device at the given index, along with an optional continuation (an empty function means none)
+// Both run on a worker thread, and tasks may be submitted from continuations, which allows chaining operations on a device without waiting for them in the calling thread
+void GF2Executor::submit(size_t device, const Task &task, const Continuation &continuation, int &errcnt, std::string &errstr)
+{
+    if (device >= strands_.size()) {
+        ++errcnt;
+        errstr += "In submit(): Device index must be less than the number of devices in the group.\n";  // Program logic error
+    } else if (!task) {
+        ++errcnt;
+        errstr += "In submit(): Task must not be empty.\n";  // Program logic error
+    } else {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++outstanding_;
+        }
+        Strand &strand = *strands_[device];
+        bool idle;
+        {
+            std::lock_guard<std::mutex> lock(strand.mutex);
+            strand.jobs.push_back({task, continuation});
+            idle = !strand.scheduled;
+            strand.scheduled = true;
+        }
+        if (idle) {
+            schedule(device);
+        }
+    }
+}
+
+// Waits until all submitted tasks complete, including any tasks submitted by their continuations
+// Note that this procedure must not be called from a task or a continuation, since it would never return
+void GF2Executor::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return outstanding_ == 0; });
+}
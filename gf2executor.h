@@ -0,0 +1,103 @@
+/* GF2 executor class - Version 1.0.0
+   Requires GF2 device group class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2EXECUTOR_H
+#define GF2EXECUTOR_H
+
+// Includes
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "gf2devicegroup.h"
+
+// Strand pool, consisting of worker threads that run tasks bound to the devices of a group, using far fewer threads than devices
+// Tasks bound to the same device form a strand: they run one at a time and in submission order, while tasks bound to different devices run concurrently
+// A worker never waits for a busy device: tasks bound to it are queued, and the device is only scheduled once it becomes free
+// Each worker serves the devices in its own queue in turn, and steals the oldest ready device of another worker when its queue is empty
+// Since transfers are synchronous, a worker is blocked on USB I/O for as long as a task runs, so that there are never more tasks in progress than workers
+// A continuation runs on the same worker once its task returns, and is meant for follow-up work, such as submitting the next task
+// Note that the group must not change while the executor exists
+class GF2Executor
+{
+public:
+    typedef std::function<void(GF2Device &device, int &errcnt, std::string &errstr)> Task;
+    typedef std::function<void(int errcnt, const std::string &errstr)> Continuation;  // Runs after the task completes, with its errors
+
+    struct Statistics {
+        uint64_t tasks;   // Number of tasks that completed, including their continuations
+        uint64_t steals;  // Number of times a worker took a device from the queue of another worker
+
+        bool operator ==(const Statistics &other) const;
+        bool operator !=(const Statistics &other) const;
+    };
+
+private:
+    struct Job {
+        Task task;
+        Continuation continuation;
+    };
+
+    struct Strand {
+        std::mutex mutex;
+        std::deque<Job> jobs;  // Tasks pending on the device
+        bool scheduled;        // True if the device is in a queue or running a task
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<size_t> devices;  // Devices that are ready to run their next task
+    };
+
+    GF2DeviceGroup &group_;
+    std::vector<std::unique_ptr<Strand>> strands_;
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;           // Guards the members below
+    std::condition_variable ready_, idle_;
+    size_t queued_;                      // Number of devices in the queues
+    size_t outstanding_;                 // Number of tasks that were submitted but did not complete yet
+    size_t next_;                        // Queue that receives the next device scheduled from outside the workers
+    bool stopping_;
+    Statistics statistics_;
+
+    void run(size_t worker);
+    void schedule(size_t device);
+    bool take(size_t worker, size_t &device);
+
+public:
+    explicit GF2Executor(GF2DeviceGroup &group, size_t threads = 0);
+    ~GF2Executor();
+
+    Statistics getStatistics() const;
+    size_t getThreads() const;
+
+    void submit(size_t device, const Task &task, const Continuation &continuation, int &errcnt, std::string &errstr);
+    void wait();
+};
+
+#endif  // GF2EXECUTOR_H
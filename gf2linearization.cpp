@@ -0,0 +1,189 @@
+/* GF2 linearization class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "gf2linearization.h"
+
+// Definitions
+const float LEVEL_SCALE = (GF2Linearization::LEVELS - 1) / GF2Linearization::AMPLITUDE_MAX;  // Levels per Vpp
+
+// Returns the given amplitude, clamped to the range of the table
+static float clamp(float amplitude)
+{
+    return amplitude < 0 ? 0 : (amplitude > GF2Linearization::AMPLITUDE_MAX ? GF2Linearization::AMPLITUDE_MAX : amplitude);
+}
+
+// Returns the table level corresponding to the given amplitude
+static size_t level(float amplitude)
+{
+    return static_cast<size_t>(clamp(amplitude) * LEVEL_SCALE + 0.5f);
+}
+
+// Inverts a curve of measured amplitudes, sorted by code, into the fractional code required for each table level
+// Levels outside the measured range get the code of the nearest end of the curve
+static std::vector<double> invert(const std::vector<GF2Linearization::Point> &curve)
+{
+    std::vector<double> codes(GF2Linearization::LEVELS);
+    size_t segment = 0;
+    for (size_t i = 0; i < GF2Linearization::LEVELS; ++i) {
+        float amplitude = i / LEVEL_SCALE;
+        while (segment + 2 < curve.size() && amplitude > curve[segment + 1].amplitude) {
+            ++segment;  // Levels increase monotonically, so the search resumes from the previous segment
+        }
+        const GF2Linearization::Point &low = curve[segment];
+        const GF2Linearization::Point &high = curve[segment + 1];
+        if (amplitude <= low.amplitude) {
+            codes[i] = low.code;
+        } else if (amplitude >= high.amplitude) {
+            codes[i] = high.code;
+        } else {
+            codes[i] = low.code + static_cast<double>(amplitude - low.amplitude) * (high.code - low.code) / (high.amplitude - low.amplitude);
+        }
+    }
+    return codes;
+}
+
+// "Equal to" operator for Point
+bool GF2Linearization::Point::operator ==(const GF2Linearization::Point &other) const
+{
+    return frequency == other.frequency && code == other.code && amplitude == other.amplitude;
+}
+
+// "Not equal to" operator for Point
+bool GF2Linearization::Point::operator !=(const GF2Linearization::Point &other) const
+{
+    return !(operator ==(other));
+}
+
+// Private procedure used to recompute the table from the measurements
+// Each band gets the inverted curve interpolated at its center frequency, between the curves measured at the nearest frequencies below and above
+void GF2Linearization::rebuild()
+{
+    std::map<float, std::vector<Point>> curves;
+    for (const Point &point : points_) {
+        curves[point.frequency].push_back(point);
+    }
+    std::vector<float> frequencies;
+    std::vector<std::vector<double>> inverted;
+    for (std::pair<const float, std::vector<Point>> &curve : curves) {
+        frequencies.push_back(curve.first);
+        inverted.push_back(invert(curve.second));
+    }
+    bands_ = frequencies.size() > 1 ? BANDS : frequencies.size();
+    codes_.assign(bands_ * LEVELS, 0);
+    for (size_t band = 0; band < bands_; ++band) {
+        float center = (band + 0.5f) * FREQUENCY_RANGE / BANDS;
+        size_t above = std::upper_bound(frequencies.begin(), frequencies.end(), center) - frequencies.begin();
+        size_t below = above == 0 ? 0 : above - 1;
+        above = std::min(above, frequencies.size() - 1);
+        double weight = above == below ? 0 : (center - frequencies[below]) / (frequencies[above] - frequencies[below]);
+        for (size_t i = 0; i < LEVELS; ++i) {
+            double code = inverted[below][i] + weight * (inverted[above][i] - inverted[below][i]);
+            codes_[LEVELS * band + i] = static_cast<uint16_t>(std::min(code + 0.5, static_cast<double>(CODE_MAX)));
+        }
+    }
+}
+
+// "GF2Linearization" class constructor
+// The linearization is initially the identity, which corresponds to the nominal linear conversion
+GF2Linearization::GF2Linearization() :
+    points_(),
+    codes_(),
+    bands_(0)
+{
+}
+
+// Returns the DAC code corresponding to the given amplitude (in Vpp), at the given frequency (in KHz)
+// If the measurements were taken at a single frequency, the frequency is irrelevant
+uint16_t GF2Linearization::amplitudeCode(float amplitude, float frequency) const
+{
+    uint16_t retval;
+    if (bands_ == 0) {
+        retval = static_cast<uint16_t>(clamp(amplitude) * CODE_MAX / AMPLITUDE_MAX + 0.5);  // Same conversion as in previous versions of GF2Device::setAmplitude()
+    } else {
+        size_t band = bands_ == 1 ? 0 : std::min(static_cast<size_t>(std::max(frequency, 0.0f) * BANDS / FREQUENCY_RANGE), BANDS - 1);
+        retval = codes_[LEVELS * band + level(amplitude)];
+    }
+    return retval;
+}
+
+// Converts a sequence of amplitudes (in Vpp) into DAC codes, at the given frequency (in KHz), which is useful for generating envelopes
+// The loop body consists of a table lookup only, so that the compiler may vectorize it
+void GF2Linearization::amplitudeCodes(const float *amplitudes, size_t count, float frequency, uint16_t *codes) const
+{
+    if (bands_ == 0) {
+        for (size_t i = 0; i < count; ++i) {
+            codes[i] = static_cast<uint16_t>(clamp(amplitudes[i]) * CODE_MAX / AMPLITUDE_MAX + 0.5);
+        }
+    } else {
+        size_t band = bands_ == 1 ? 0 : std::min(static_cast<size_t>(std::max(frequency, 0.0f) * BANDS / FREQUENCY_RANGE), BANDS - 1);
+        const uint16_t *row = codes_.data() + LEVELS * band;
+        for (size_t i = 0; i < count; ++i) {
+            codes[i] = row[level(amplitudes[i])];
+        }
+    }
+}
+
+// Returns the measurements, sorted by frequency and then by code
+std::vector<GF2Linearization::Point> GF2Linearization::getPoints() const
+{
+    return points_;
+}
+
+// Returns true if the measurements were taken at more than one frequency, meaning that the DAC code depends on the frequency
+bool GF2Linearization::isFrequencyDependent() const
+{
+    return bands_ > 1;
+}
+
+// Returns true if no measurements were given, meaning that the nominal linear conversion is used
+bool GF2Linearization::isIdentity() const
+{
+    return bands_ == 0;
+}
+
+// Sets the measurements, which need not be sorted, replacing any previous ones (an empty vector restores the identity)
+// At each frequency, there must be at least two measurements, and the measured amplitudes must strictly increase with the code
+// For full range coverage, the measurements at each frequency should include codes 0 and "CODE_MAX" [1023]
+void GF2Linearization::setPoints(const std::vector<Point> &points, int &errcnt, std::string &errstr)
+{
+    std::vector<Point> sorted = points;
+    std::sort(sorted.begin(), sorted.end(), [](const Point &a, const Point &b) {
+        return a.frequency < b.frequency || (a.frequency == b.frequency && a.code < b.code);
+    });
+    bool valid = true;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        bool first = i == 0 || sorted[i].frequency != sorted[i - 1].frequency;
+        bool last = i + 1 == sorted.size() || sorted[i].frequency != sorted[i + 1].frequency;
+        valid = valid && sorted[i].frequency >= 0 && sorted[i].frequency <= FREQUENCY_RANGE && sorted[i].code <= CODE_MAX && sorted[i].amplitude >= 0 && std::isfinite(sorted[i].amplitude);
+        valid = valid && !(first && last);  // A single measurement at a given frequency cannot be inverted
+        valid = valid && (first || (sorted[i].code > sorted[i - 1].code && sorted[i].amplitude > sorted[i - 1].amplitude));
+    }
+    if (!valid) {
+        ++errcnt;
+        errstr += "In setPoints(): Measurements must have frequencies between 0 and 40000 and codes between 0 and 1023, and there must be at least two per frequency, with amplitudes strictly increasing with the code.\n";  // Program logic error
+    } else {
+        points_ = sorted;
+        rebuild();
+    }
+}
@@ -0,0 +1,71 @@
+/* GF2 linearization class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2LINEARIZATION_H
+#define GF2LINEARIZATION_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Amplitude linearization of a GF2 device, built from the output amplitudes measured for several AD5310 DAC codes, optionally at several frequencies
+// The measurements are inverted into a dense table of DAC codes, indexed by amplitude level and frequency band, so that each lookup takes constant time
+// Without measurements, the nominal linear conversion is used
+class GF2Linearization
+{
+public:
+    // Class definitions
+    static const size_t LEVELS = 2048;               // Number of amplitude levels of the table, which is twice the resolution of the AD5310 DAC
+    static const size_t BANDS = 40;                  // Number of frequency bands of the table, if measurements were taken at more than one frequency
+    static constexpr float AMPLITUDE_MAX = 8;        // Amplitude corresponding to the last level, matching the range of GF2Device::setAmplitude()
+    static constexpr float FREQUENCY_RANGE = 40000;  // Frequency range spanned by the bands, matching the range of GF2Device::setFrequency()
+    static const uint16_t CODE_MAX = 1023;           // Maximum code of the AD5310 DAC
+
+    struct Point {
+        float frequency;  // Frequency (in KHz) at which the measurement was taken
+        uint16_t code;    // DAC code that was set
+        float amplitude;  // Output amplitude that was measured (in Vpp)
+
+        bool operator ==(const Point &other) const;
+        bool operator !=(const Point &other) const;
+    };
+
+private:
+    std::vector<Point> points_;
+    std::vector<uint16_t> codes_;
+    size_t bands_;
+
+    void rebuild();
+
+public:
+    GF2Linearization();
+
+    uint16_t amplitudeCode(float amplitude, float frequency = 0) const;
+    void amplitudeCodes(const float *amplitudes, size_t count, float frequency, uint16_t *codes) const;
+    std::vector<Point> getPoints() const;
+    bool isFrequencyDependent() const;
+    bool isIdentity() const;
+
+    void setPoints(const std::vector<Point> &points, int &errcnt, std::string &errstr);
+};
+
+#endif  // GF2LINEARIZATION_H
@@ -0,0 +1,180 @@
+/* GF2 metrics class - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <sstream>
+#include "gf2metrics.h"
+
+// Helper function used to escape a label value, as required by the Prometheus text format
+static std::string escapeLabel(const std::string &value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+GF2Metrics::GF2Metrics() :
+    mutex_(),
+    devices_()
+{
+}
+
+// Adds a device to the registry, labeled with the given serial number
+// Note that the device is not owned by the registry, and it must remain valid until removed
+void GF2Metrics::addDevice(const std::string &serial, const GF2Device *device)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_[serial] = device;
+}
+
+// Returns the metrics of all registered devices, in the Prometheus text exposition format
+// This function can be called from any thread (e.g., from an HTTP handler), since the statistics, the open and disconnected states and the register state of each device are read atomically
+// Generator values that are not known (e.g., registers not written since the device was opened) are left out
+std::string GF2Metrics::getExposition() const
+{
+    std::map<std::string, CP2130::Statistics> statistics;
+    std::map<std::string, std::pair<bool, bool>> states;  // Open and disconnected states, respectively
+    std::map<std::string, GF2Device::RegisterState> registers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const std::pair<const std::string, const GF2Device *> &device : devices_) {
+            std::string label = escapeLabel(device.first);
+            statistics[label] = device.second->getStatistics();
+            states[label] = std::make_pair(device.second->isOpen(), device.second->disconnected());
+            registers[label] = device.second->getRegisterState();
+        }
+    }
+    std::ostringstream stream;
+    stream << "# HELP gf2_usb_transfers_total Number of USB transfers made to the device." << std::endl
+           << "# TYPE gf2_usb_transfers_total counter" << std::endl;
+    for (const std::pair<const std::string, CP2130::Statistics> &entry : statistics) {
+        stream << "gf2_usb_transfers_total{serial=\"" << entry.first << "\",type=\"control\"} " << entry.second.controlTransfers << std::endl
+               << "gf2_usb_transfers_total{serial=\"" << entry.first << "\",type=\"bulk\"} " << entry.second.bulkTransfers << std::endl;
+    }
+    stream << "# HELP gf2_usb_bytes_total Number of bytes transferred to or from the device." << std::endl
+           << "# TYPE gf2_usb_bytes_total counter" << std::endl;
+    for (const std::pair<const std::string, CP2130::Statistics> &entry : statistics) {
+        stream << "gf2_usb_bytes_total{serial=\"" << entry.first << "\",direction=\"in\"} " << entry.second.bytesIn << std::endl
+               << "gf2_usb_bytes_total{serial=\"" << entry.first << "\",direction=\"out\"} " << entry.second.bytesOut << std::endl;
+    }
+    stream << "# HELP gf2_usb_errors_total Number of failed USB transfers." << std::endl
+           << "# TYPE gf2_usb_errors_total counter" << std::endl;
+    for (const std::pair<const std::string, CP2130::Statistics> &entry : statistics) {
+        stream << "gf2_usb_errors_total{serial=\"" << entry.first << "\"} " << entry.second.errors << std::endl;
+    }
+    stream << "# HELP gf2_reconnects_total Number of times the device was reopened after being disconnected." << std::endl
+           << "# TYPE gf2_reconnects_total counter" << std::endl;
+    for (const std::pair<const std::string, CP2130::Statistics> &entry : statistics) {
+        stream << "gf2_reconnects_total{serial=\"" << entry.first << "\"} " << entry.second.reconnects << std::endl;
+    }
+    stream << "# HELP gf2_usb_transfer_duration_seconds Duration of USB transfers." << std::endl
+           << "# TYPE gf2_usb_transfer_duration_seconds histogram" << std::endl;
+    for (const std::pair<const std::string, CP2130::Statistics> &entry : statistics) {
+        uint64_t count = 0;
+        for (size_t i = 0; i < CP2130::LATENCY_BUCKETS; ++i) {
+            count += entry.second.latencyBuckets[i];  // Prometheus buckets are cumulative
+            stream << "gf2_usb_transfer_duration_seconds_bucket{serial=\"" << entry.first << "\",le=\"";
+            if (i < CP2130::LATENCY_BUCKETS - 1) {
+                stream << CP2130::latencyBound(i) / 1e6;
+            } else {
+                stream << "+Inf";
+            }
+            stream << "\"} " << count << std::endl;
+        }
+        stream << "gf2_usb_transfer_duration_seconds_sum{serial=\"" << entry.first << "\"} " << entry.second.latencySum / 1e6 << std::endl
+               << "gf2_usb_transfer_duration_seconds_count{serial=\"" << entry.first << "\"} " << count << std::endl;
+    }
+    stream << "# HELP gf2_device_open Whether the device is open." << std::endl
+           << "# TYPE gf2_device_open gauge" << std::endl;
+    for (const std::pair<const std::string, std::pair<bool, bool>> &entry : states) {
+        stream << "gf2_device_open{serial=\"" << entry.first << "\"} " << entry.second.first << std::endl;
+    }
+    stream << "# HELP gf2_device_disconnected Whether the device was found to be disconnected." << std::endl
+           << "# TYPE gf2_device_disconnected gauge" << std::endl;
+    for (const std::pair<const std::string, std::pair<bool, bool>> &entry : states) {
+        stream << "gf2_device_disconnected{serial=\"" << entry.first << "\"} " << entry.second.second << std::endl;
+    }
+    stream.precision(10);  // Enough significant digits for frequencies up to 40MHz, with a resolution below 1Hz
+    stream << "# HELP gf2_frequency_hertz Frequency held by each FREQ register, assuming the nominal master clock." << std::endl
+           << "# TYPE gf2_frequency_hertz gauge" << std::endl;
+    for (const std::pair<const std::string, GF2Device::RegisterState> &entry : registers) {
+        for (size_t i = 0; i < 2; ++i) {
+            if (entry.second.frequencyKnown[i]) {
+                stream << "gf2_frequency_hertz{serial=\"" << entry.first << "\",register=\"" << i << "\"} " << 1000.0 * entry.second.frequencies[i] << std::endl;
+            }
+        }
+    }
+    stream << "# HELP gf2_phase_degrees Phase held by each PHASE register." << std::endl
+           << "# TYPE gf2_phase_degrees gauge" << std::endl;
+    for (const std::pair<const std::string, GF2Device::RegisterState> &entry : registers) {
+        for (size_t i = 0; i < 2; ++i) {
+            if (entry.second.phaseKnown[i]) {
+                stream << "gf2_phase_degrees{serial=\"" << entry.first << "\",register=\"" << i << "\"} " << entry.second.phases[i] << std::endl;
+            }
+        }
+    }
+    stream << "# HELP gf2_frequency_selected Index of the active FREQ register." << std::endl
+           << "# TYPE gf2_frequency_selected gauge" << std::endl;
+    for (const std::pair<const std::string, GF2Device::RegisterState> &entry : registers) {
+        if (entry.second.fselKnown) {
+            stream << "gf2_frequency_selected{serial=\"" << entry.first << "\"} " << entry.second.fsel << std::endl;
+        }
+    }
+    stream << "# HELP gf2_phase_selected Index of the active PHASE register." << std::endl
+           << "# TYPE gf2_phase_selected gauge" << std::endl;
+    for (const std::pair<const std::string, GF2Device::RegisterState> &entry : registers) {
+        if (entry.second.pselKnown) {
+            stream << "gf2_phase_selected{serial=\"" << entry.first << "\"} " << entry.second.psel << std::endl;
+        }
+    }
+    stream << "# HELP gf2_amplitude_code Code held by the DAC that sets the amplitude, from 0 to 1023." << std::endl
+           << "# TYPE gf2_amplitude_code gauge" << std::endl;
+    for (const std::pair<const std::string, GF2Device::RegisterState> &entry : registers) {
+        if (entry.second.amplitudeKnown) {
+            stream << "gf2_amplitude_code{serial=\"" << entry.first << "\"} " << entry.second.amplitudeCode << std::endl;
+        }
+    }
+    stream << "# HELP gf2_waveform_triangular Whether the waveform is triangular (1) or sinusoidal (0)." << std::endl
+           << "# TYPE gf2_waveform_triangular gauge" << std::endl;
+    for (const std::pair<const std::string, GF2Device::RegisterState> &entry : registers) {
+        if (entry.second.waveformKnown) {
+            stream << "gf2_waveform_triangular{serial=\"" << entry.first << "\"} " << entry.second.triangle << std::endl;
+        }
+    }
+    return stream.str();
+}
+
+// Removes a device from the registry
+void GF2Metrics::removeDevice(const std::string &serial)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices_.erase(serial);
+}
@@ -0,0 +1,45 @@
+/* GF2 metrics class - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2METRICS_H
+#define GF2METRICS_H
+
+// Includes
+#include <map>
+#include <mutex>
+#include <string>
+#include "gf2device.h"
+
+class GF2Metrics
+{
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, const GF2Device *> devices_;
+
+public:
+    GF2Metrics();
+
+    void addDevice(const std::string &serial, const GF2Device *device);
+    std::string getExposition() const;
+    void removeDevice(const std::string &serial);
+};
+
+#endif  // GF2METRICS_H
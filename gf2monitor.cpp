@@ -0,0 +1,264 @@
+/* GF2 monitor class - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <sys/time.h>
+#include "gf2monitor.h"
+
+// Private procedure used to process the hotplug events queued by hotplugCallback()
+// Arriving devices are opened only once, in order to read their serial number, which is then associated with their location
+void GF2Monitor::processEvents()
+{
+    while (!events_.empty()) {
+        Event event = events_.front();
+        events_.pop_front();
+        uint16_t location = static_cast<uint16_t>(libusb_get_bus_number(event.device) << 8 | libusb_get_device_address(event.device));  // The bus number and address identify the device until it leaves
+        if (event.event == LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED) {
+            libusb_device_descriptor desc;
+            libusb_device_handle *handle;
+            if (libusb_get_device_descriptor(event.device, &desc) == 0 && libusb_open(event.device, &handle) == 0) {
+                unsigned char str_desc[256];
+                if (libusb_get_string_descriptor_ascii(handle, desc.iSerialNumber, str_desc, static_cast<int>(sizeof(str_desc))) >= 0) {  // Get the serial number string in ASCII format
+                    std::string serial = reinterpret_cast<char *>(str_desc);
+                    locations_[location] = serial;
+                    std::map<std::string, Entry>::iterator entry = entries_.find(serial);
+                    if (entry != entries_.end()) {
+                        entry->second.health.present = true;
+                        entry->second.health.lastSeen = std::chrono::steady_clock::now();
+                    }
+                }
+                libusb_close(handle);
+            }
+        } else {
+            std::map<uint16_t, std::string>::iterator serial = locations_.find(location);
+            if (serial != locations_.end()) {
+                std::map<std::string, Entry>::iterator entry = entries_.find(serial->second);
+                if (entry != entries_.end()) {
+                    entry->second.health.present = false;
+                    entry->second.health.responsive = false;
+                }
+                locations_.erase(serial);
+            }
+        }
+        libusb_unref_device(event.device);  // Release the reference taken by hotplugCallback()
+    }
+}
+
+// Private procedure used to run any heartbeats that are due
+// Each heartbeat consists of a single GPIO read, and devices that are known to be absent or that are not open are skipped
+void GF2Monitor::runHeartbeats()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (std::pair<const std::string, Entry> &entry : entries_) {
+        Entry &monitored = entry.second;
+        if (now >= monitored.nextHeartbeat && monitored.health.present && monitored.device->isOpen()) {
+            int errcnt = 0;
+            std::string errstr;
+            GF2Device::Status status = monitored.device->getStatus(errcnt, errstr);
+            if (errcnt == 0) {
+                monitored.health.responsive = true;
+                monitored.health.status = status;
+                monitored.health.failures = 0;
+                monitored.health.lastSeen = now;
+            } else {
+                monitored.health.responsive = false;
+                ++monitored.health.failures;
+                if (!hotplug_ && monitored.device->disconnected()) {  // Without hotplug support, a disconnection can only be detected this way
+                    monitored.health.present = false;
+                }
+            }
+            monitored.nextHeartbeat = now + interval_;
+        }
+    }
+}
+
+// Private procedure used to spread the heartbeats of all devices evenly over each interval, instead of having them issued in bursts
+// This is done whenever the number of devices or the interval changes, so that the offsets always match the actual number of devices
+void GF2Monitor::staggerHeartbeats()
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    size_t index = 0;
+    for (std::pair<const std::string, Entry> &entry : entries_) {
+        entry.second.nextHeartbeat = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval_) * index / entries_.size();
+        ++index;
+    }
+}
+
+// Private callback function that queues hotplug events, so that they are processed outside libusb's event handling
+int LIBUSB_CALL GF2Monitor::hotplugCallback(libusb_context *, libusb_device *device, libusb_hotplug_event event, void *userData)
+{
+    GF2Monitor *monitor = static_cast<GF2Monitor *>(userData);
+    Event queued = {libusb_ref_device(device), event};
+    monitor->events_.push_back(queued);
+    return 0;  // Keep the callback registered
+}
+
+// "Equal to" operator for Health
+bool GF2Monitor::Health::operator ==(const GF2Monitor::Health &other) const
+{
+    return present == other.present && responsive == other.responsive && status == other.status && failures == other.failures && lastSeen == other.lastSeen;
+}
+
+// "Not equal to" operator for Health
+bool GF2Monitor::Health::operator !=(const GF2Monitor::Health &other) const
+{
+    return !(operator ==(other));
+}
+
+GF2Monitor::GF2Monitor() :
+    context_(nullptr),
+    callback_(),
+    running_(false),
+    hotplug_(false),
+    interval_(static_cast<int>(HEARTBEAT_INTERVAL)),  // The cast avoids the need for an out-of-class definition of the constant
+    entries_(),
+    locations_(),
+    events_()
+{
+}
+
+GF2Monitor::~GF2Monitor()
+{
+    stop();
+}
+
+// Checks if presence is being tracked via hotplug events
+bool GF2Monitor::hasHotplug() const
+{
+    return hotplug_;
+}
+
+// Checks if the monitor is running
+bool GF2Monitor::isRunning() const
+{
+    return running_;
+}
+
+// Adds a device to be monitored, identified by its serial number
+// Note that the device is not owned by the monitor, and it must remain valid until removed
+void GF2Monitor::addDevice(const std::string &serial, GF2Device *device)
+{
+    Entry entry;
+    entry.device = device;
+    entry.health.present = !hotplug_;  // Without hotplug events, devices are assumed to be present until proven otherwise
+    entry.health.responsive = false;
+    entry.health.status = {false, false, false, false, false};
+    entry.health.failures = 0;
+    entry.health.lastSeen = std::chrono::steady_clock::time_point();
+    for (const std::pair<const uint16_t, std::string> &location : locations_) {
+        if (location.second == serial) {  // The device may have arrived before being added
+            entry.health.present = true;
+            entry.health.lastSeen = std::chrono::steady_clock::now();
+        }
+    }
+    entries_[serial] = entry;
+    staggerHeartbeats();
+}
+
+// Returns the health of a monitored device
+GF2Monitor::Health GF2Monitor::getHealth(const std::string &serial) const
+{
+    Health health = {false, false, {false, false, false, false, false}, 0, std::chrono::steady_clock::time_point()};
+    std::map<std::string, Entry>::const_iterator entry = entries_.find(serial);
+    if (entry != entries_.end()) {
+        health = entry->second.health;
+    }
+    return health;
+}
+
+// Returns the serial numbers of all monitored devices
+std::list<std::string> GF2Monitor::listDevices() const
+{
+    std::list<std::string> serials;
+    for (const std::pair<const std::string, Entry> &entry : entries_) {
+        serials.push_back(entry.first);
+    }
+    return serials;
+}
+
+// Waits up to the given timeout (in milliseconds) for hotplug events, processes them, and then runs any heartbeats that are due
+// This function is meant to be called periodically, from a single thread
+void GF2Monitor::poll(int timeout, int &errcnt, std::string &errstr)
+{
+    if (!running_) {
+        ++errcnt;
+        errstr += "In poll(): monitor is not running.\n";  // Program logic error
+    } else {
+        if (hotplug_) {
+            timeval tv = {timeout / 1000, 1000 * (timeout % 1000)};
+            if (libusb_handle_events_timeout_completed(context_, &tv, nullptr) != 0) {
+                ++errcnt;
+                errstr += "Failed to handle hotplug events.\n";
+            }
+            processEvents();
+        }
+        runHeartbeats();
+    }
+}
+
+// Stops monitoring a device
+void GF2Monitor::removeDevice(const std::string &serial)
+{
+    entries_.erase(serial);
+    staggerHeartbeats();
+}
+
+// Sets the heartbeat interval, in milliseconds
+void GF2Monitor::setHeartbeatInterval(int interval)
+{
+    interval_ = std::chrono::milliseconds(interval);
+    staggerHeartbeats();
+}
+
+// Starts monitoring, registering for hotplug events if these are supported
+int GF2Monitor::start()
+{
+    int retval;
+    if (running_) {
+        retval = SUCCESS;
+    } else if (libusb_init(&context_) != 0) {  // Initialize libusb. In case of failure
+        retval = ERROR_INIT;
+    } else {
+        hotplug_ = libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG) != 0 && libusb_hotplug_register_callback(context_, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED | LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT, LIBUSB_HOTPLUG_ENUMERATE, GF2Device::VID, GF2Device::PID, LIBUSB_HOTPLUG_MATCH_ANY, hotplugCallback, this, &callback_) == LIBUSB_SUCCESS;  // Devices that are already attached are reported as arrivals
+        for (std::pair<const std::string, Entry> &entry : entries_) {
+            entry.second.health.present = !hotplug_;  // With hotplug events, presence is established by the arrival events
+        }
+        processEvents();
+        running_ = true;
+        retval = SUCCESS;
+    }
+    return retval;
+}
+
+// Stops monitoring, if running
+void GF2Monitor::stop()
+{
+    if (running_) {
+        if (hotplug_) {
+            libusb_hotplug_deregister_callback(context_, callback_);
+        }
+        processEvents();  // Releases any pending device references
+        libusb_exit(context_);  // Deinitialize libusb
+        locations_.clear();
+        hotplug_ = false;
+        running_ = false;
+    }
+}
@@ -0,0 +1,97 @@
+/* GF2 monitor class - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2MONITOR_H
+#define GF2MONITOR_H
+
+// Includes
+#include <chrono>
+#include <list>
+#include <map>
+#include <string>
+#include <libusb-1.0/libusb.h>
+#include "gf2device.h"
+
+class GF2Monitor
+{
+public:
+    struct Health {
+        bool present;                                    // True if the device is attached, as reported by hotplug events
+        bool responsive;                                 // True if the last heartbeat succeeded
+        GF2Device::Status status;                        // State of the control lines, as read on the last successful heartbeat
+        int failures;                                    // Number of consecutive failed heartbeats
+        std::chrono::steady_clock::time_point lastSeen;  // Time of the last arrival event or successful heartbeat
+
+        bool operator ==(const Health &other) const;
+        bool operator !=(const Health &other) const;
+    };
+
+private:
+    struct Entry {
+        GF2Device *device;                                    // Monitored device (owned by the caller)
+        Health health;                                        // Current health of the device
+        std::chrono::steady_clock::time_point nextHeartbeat;  // Time at which the next heartbeat is due
+    };
+
+    struct Event {
+        libusb_device *device;       // Device that arrived or left (referenced until processed)
+        libusb_hotplug_event event;  // Event type
+    };
+
+    libusb_context *context_;
+    libusb_hotplug_callback_handle callback_;
+    bool running_, hotplug_;
+    std::chrono::milliseconds interval_;
+    std::map<std::string, Entry> entries_;
+    std::map<uint16_t, std::string> locations_;
+    std::list<Event> events_;
+
+    void processEvents();
+    void runHeartbeats();
+    void staggerHeartbeats();
+
+    static int LIBUSB_CALL hotplugCallback(libusb_context *context, libusb_device *device, libusb_hotplug_event event, void *userData);
+
+public:
+    // Class definitions
+    static const int SUCCESS = 0;     // Returned by start() if successful
+    static const int ERROR_INIT = 1;  // Returned by start() in case of a libusb initialization failure
+
+    // Default applicable to setHeartbeatInterval()
+    static const int HEARTBEAT_INTERVAL = 1000;  // Default heartbeat interval, in milliseconds
+
+    GF2Monitor();
+    ~GF2Monitor();
+
+    bool hasHotplug() const;
+    bool isRunning() const;
+
+    void addDevice(const std::string &serial, GF2Device *device);
+    Health getHealth(const std::string &serial) const;
+    std::list<std::string> listDevices() const;
+    void poll(int timeout, int &errcnt, std::string &errstr);
+    void removeDevice(const std::string &serial);
+    void setHeartbeatInterval(int interval);
+    int start();
+    void stop();
+};
+
+#endif  // GF2MONITOR_H
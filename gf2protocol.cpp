@@ -0,0 +1,179 @@
+/* GF2 protocol class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstring>
+#include "gf2protocol.h"
+
+// Reads a 16-bit value in little-endian byte order
+static uint16_t readLE16(const uint8_t *buffer)
+{
+    return static_cast<uint16_t>(buffer[1] << 8 | buffer[0]);
+}
+
+// Reads a 32-bit value in little-endian byte order
+static uint32_t readLE32(const uint8_t *buffer)
+{
+    return static_cast<uint32_t>(buffer[3]) << 24 | static_cast<uint32_t>(buffer[2]) << 16 | static_cast<uint32_t>(buffer[1]) << 8 | buffer[0];
+}
+
+// Writes a 16-bit value in little-endian byte order
+static void writeLE16(uint16_t value, uint8_t *buffer)
+{
+    buffer[0] = static_cast<uint8_t>(value);
+    buffer[1] = static_cast<uint8_t>(value >> 8);
+}
+
+// Writes a 32-bit value in little-endian byte order
+static void writeLE32(uint32_t value, uint8_t *buffer)
+{
+    buffer[0] = static_cast<uint8_t>(value);
+    buffer[1] = static_cast<uint8_t>(value >> 8);
+    buffer[2] = static_cast<uint8_t>(value >> 16);
+    buffer[3] = static_cast<uint8_t>(value >> 24);
+}
+
+// "Equal to" operator for Request
+bool GF2Protocol::Request::operator ==(const GF2Protocol::Request &other) const
+{
+    return opcode == other.opcode && id == other.id && device == other.device && selection == other.selection && value == other.value;
+}
+
+// "Not equal to" operator for Request
+bool GF2Protocol::Request::operator !=(const GF2Protocol::Request &other) const
+{
+    return !(operator ==(other));
+}
+
+// "Equal to" operator for Response
+bool GF2Protocol::Response::operator ==(const GF2Protocol::Response &other) const
+{
+    return opcode == other.opcode && id == other.id && status == other.status && length == other.length && value == other.value;
+}
+
+// "Not equal to" operator for Response
+bool GF2Protocol::Response::operator !=(const GF2Protocol::Response &other) const
+{
+    return !(operator ==(other));
+}
+
+// "Equal to" operator for DeviceEntry
+bool GF2Protocol::DeviceEntry::operator ==(const GF2Protocol::DeviceEntry &other) const
+{
+    return index == other.index && connected == other.connected && serial == other.serial;
+}
+
+// "Not equal to" operator for DeviceEntry
+bool GF2Protocol::DeviceEntry::operator !=(const GF2Protocol::DeviceEntry &other) const
+{
+    return !(operator ==(other));
+}
+
+// Decodes a request from a buffer of "REQUEST_SIZE" [16] bytes, returning false if the magic number or version do not match
+bool GF2Protocol::decodeRequest(const uint8_t *buffer, Request &request)
+{
+    bool retval = readLE16(buffer) == MAGIC && buffer[2] == VERSION;
+    if (retval) {
+        request.opcode = buffer[3];
+        request.id = readLE32(buffer + 4);
+        request.device = readLE16(buffer + 8);
+        request.selection = buffer[10];
+        uint32_t bits = readLE32(buffer + 12);
+        std::memcpy(&request.value, &bits, sizeof(request.value));  // IEEE 754 single precision
+    }
+    return retval;
+}
+
+// Decodes a response header from a buffer of "RESPONSE_SIZE" [16] bytes, returning false if the magic number or version do not match
+bool GF2Protocol::decodeResponse(const uint8_t *buffer, Response &response)
+{
+    bool retval = readLE16(buffer) == MAGIC && buffer[2] == VERSION;
+    if (retval) {
+        response.opcode = buffer[3];
+        response.id = readLE32(buffer + 4);
+        response.status = static_cast<int16_t>(readLE16(buffer + 8));
+        response.length = readLE16(buffer + 10);
+        response.value = readLE32(buffer + 12);
+    }
+    return retval;
+}
+
+// Decodes the payload of a response to "OPLIST"
+// Each entry consists of the device index (2 bytes), the connection state (1 byte), the length of the serial number (1 byte) and the serial number itself
+std::vector<GF2Protocol::DeviceEntry> GF2Protocol::decodeDeviceList(const std::vector<uint8_t> &payload)
+{
+    std::vector<DeviceEntry> entries;
+    size_t offset = 0;
+    while (offset + 4 <= payload.size() && offset + 4 + payload[offset + 3] <= payload.size()) {
+        DeviceEntry entry;
+        entry.index = readLE16(payload.data() + offset);
+        entry.connected = payload[offset + 2] != 0x00;
+        entry.serial.assign(payload.begin() + offset + 4, payload.begin() + offset + 4 + payload[offset + 3]);
+        entries.push_back(entry);
+        offset += 4 + payload[offset + 3];
+    }
+    return entries;
+}
+
+// Encodes the payload of a response to "OPLIST" (see above)
+// Entries that would exceed "MAX_PAYLOAD" [4096] are left out
+std::vector<uint8_t> GF2Protocol::encodeDeviceList(const std::vector<DeviceEntry> &entries)
+{
+    std::vector<uint8_t> payload;
+    for (const DeviceEntry &entry : entries) {
+        size_t length = entry.serial.size() > 0xff ? 0xff : entry.serial.size();
+        if (payload.size() + 4 + length <= MAX_PAYLOAD) {
+            size_t offset = payload.size();
+            payload.resize(offset + 4 + length);
+            writeLE16(entry.index, payload.data() + offset);
+            payload[offset + 2] = entry.connected ? 0x01 : 0x00;
+            payload[offset + 3] = static_cast<uint8_t>(length);
+            std::memcpy(payload.data() + offset + 4, entry.serial.data(), length);
+        }
+    }
+    return payload;
+}
+
+// Encodes a request into a buffer of "REQUEST_SIZE" [16] bytes
+void GF2Protocol::encodeRequest(const Request &request, uint8_t *buffer)
+{
+    writeLE16(MAGIC, buffer);
+    buffer[2] = VERSION;
+    buffer[3] = request.opcode;
+    writeLE32(request.id, buffer + 4);
+    writeLE16(request.device, buffer + 8);
+    buffer[10] = request.selection;
+    buffer[11] = 0x00;  // Reserved
+    uint32_t bits;
+    std::memcpy(&bits, &request.value, sizeof(bits));
+    writeLE32(bits, buffer + 12);
+}
+
+// Encodes a response header into a buffer of "RESPONSE_SIZE" [16] bytes
+void GF2Protocol::encodeResponse(const Response &response, uint8_t *buffer)
+{
+    writeLE16(MAGIC, buffer);
+    buffer[2] = VERSION;
+    buffer[3] = response.opcode;
+    writeLE32(response.id, buffer + 4);
+    writeLE16(static_cast<uint16_t>(response.status), buffer + 8);
+    writeLE16(response.length, buffer + 10);
+    writeLE32(response.value, buffer + 12);
+}
@@ -0,0 +1,111 @@
+/* GF2 protocol class - Version 1.0.0
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2PROTOCOL_H
+#define GF2PROTOCOL_H
+
+// Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Binary protocol spoken between the GF2 daemon and its clients
+// Every request and response starts with a fixed-size header, encoded in little-endian byte order
+// Requests carry a client-chosen identifier that is echoed in the response, so that clients may pipeline requests freely
+class GF2Protocol
+{
+public:
+    // Class definitions
+    static const uint16_t MAGIC = 0x3247;      // Magic number ("G2" in little-endian byte order)
+    static const uint8_t VERSION = 0x01;       // Protocol version
+    static const size_t REQUEST_SIZE = 16;     // Size of an encoded request
+    static const size_t RESPONSE_SIZE = 16;    // Size of an encoded response header, not including its payload
+    static const uint16_t MAX_PAYLOAD = 4096;  // Maximum size of a response payload
+
+    // Operations applicable to Request::opcode
+    static const uint8_t OPNONE = 0x00;      // Not an operation, but the opcode given by GF2Ring::popRequest() to a malformed request
+    static const uint8_t OPLIST = 0x01;      // Lists the devices, see decodeDeviceList(), rescanning for new devices first if "selection" is 1
+    static const uint8_t OPCLEAR = 0x10;     // GF2Device::clear()
+    static const uint8_t OPFREQ = 0x11;      // GF2Device::setFrequency(), with "selection" and "value" (in KHz)
+    static const uint8_t OPPHASE = 0x12;     // GF2Device::setPhase(), with "selection" and "value" (in degrees)
+    static const uint8_t OPAMP = 0x13;       // GF2Device::setAmplitude(), with "value" (in Vpp)
+    static const uint8_t OPWAVE = 0x14;      // GF2Device::setSineWave() if "selection" is 0, or GF2Device::setTriangleWave() if it is 1
+    static const uint8_t OPFSEL = 0x15;      // GF2Device::selectFrequency(), with "selection"
+    static const uint8_t OPPSEL = 0x16;      // GF2Device::selectPhase(), with "selection"
+    static const uint8_t OPSTART = 0x17;     // GF2Device::start()
+    static const uint8_t OPSTOP = 0x18;      // GF2Device::stop()
+    static const uint8_t OPSTATUS = 0x20;    // Returns the status bitmap in "value" (see the STBM* bitmaps)
+
+    // Status codes applicable to Response::status
+    static const int16_t STOK = 0;             // Request executed successfully
+    static const int16_t STPROTOCOL = 1;       // Malformed request or unknown operation
+    static const int16_t STNODEVICE = 2;       // No device with the given index
+    static const int16_t STARGUMENT = 3;       // Argument out of range
+    static const int16_t STIO = 4;             // Transfer error (the error string is returned as payload)
+    static const int16_t STDISCONNECTED = 5;   // The device is disconnected
+
+    // Bitmaps applicable to the value returned by "OPSTATUS"
+    static const uint32_t STBMCLOCK = 0x01;    // Clock enabled
+    static const uint32_t STBMDAC = 0x02;      // DAC enabled
+    static const uint32_t STBMWAVEGEN = 0x04;  // Waveform generator enabled
+    static const uint32_t STBMFSEL = 0x08;     // Frequency 1 selected
+    static const uint32_t STBMPSEL = 0x10;     // Phase 1 selected
+
+    struct Request {
+        uint8_t opcode;     // Operation
+        uint32_t id;        // Client-chosen identifier, echoed in the response
+        uint16_t device;    // Index of the target device, as returned by "OPLIST"
+        uint8_t selection;  // Frequency, phase or waveform selection, if applicable
+        float value;        // Argument, if applicable
+
+        bool operator ==(const Request &other) const;
+        bool operator !=(const Request &other) const;
+    };
+
+    struct Response {
+        uint8_t opcode;   // Operation of the corresponding request
+        uint32_t id;      // Identifier of the corresponding request
+        int16_t status;   // Status code
+        uint16_t length;  // Size of the payload that follows the header
+        uint32_t value;   // Returned value, if applicable
+
+        bool operator ==(const Response &other) const;
+        bool operator !=(const Response &other) const;
+    };
+
+    struct DeviceEntry {
+        uint16_t index;      // Index used to address the device
+        bool connected;      // False if the device was disconnected since it was opened
+        std::string serial;  // Serial number
+
+        bool operator ==(const DeviceEntry &other) const;
+        bool operator !=(const DeviceEntry &other) const;
+    };
+
+    static bool decodeRequest(const uint8_t *buffer, Request &request);
+    static bool decodeResponse(const uint8_t *buffer, Response &response);
+    static std::vector<DeviceEntry> decodeDeviceList(const std::vector<uint8_t> &payload);
+    static std::vector<uint8_t> encodeDeviceList(const std::vector<DeviceEntry> &entries);
+    static void encodeRequest(const Request &request, uint8_t *buffer);
+    static void encodeResponse(const Response &response, uint8_t *buffer);
+};
+
+#endif  // GF2PROTOCOL_H
@@ -0,0 +1,242 @@
+/* GF2 ring class - Version 1.0.0
+   Requires GF2 protocol class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstring>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "gf2ring.h"
+
+// Definitions
+const uint32_t RING_MAGIC = 0x47463252;  // Magic number identifying the shared memory as holding GF2 rings ("GF2R")
+const uint32_t RING_VERSION = 1;         // Layout version
+const size_t SLOT_SIZE = 16;             // Size of each slot, enough for an encoded request or response header
+
+static_assert(GF2Protocol::REQUEST_SIZE <= SLOT_SIZE && GF2Protocol::RESPONSE_SIZE <= SLOT_SIZE, "Slots are too small");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "Atomic integers must be lock-free, in order to be shared between processes");
+
+// Layout of the shared memory, which is followed by the request slots and then by the completion slots
+// Each index lives in its own cache line, so that producer and consumer do not contend over the same line
+struct GF2Ring::Shared {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+    alignas(64) std::atomic<uint32_t> requestHead;     // Written by the owner (consumer)
+    alignas(64) std::atomic<uint32_t> requestTail;     // Written by the client (producer)
+    alignas(64) std::atomic<uint32_t> completionHead;  // Written by the client (consumer)
+    alignas(64) std::atomic<uint32_t> completionTail;  // Written by the owner (producer)
+};
+
+// Pushes an encoded record into a ring, returning false if the ring is full
+// Indexes run freely, and are reduced to slot indexes by masking, since the capacity is a power of two
+static bool push(std::atomic<uint32_t> &head, std::atomic<uint32_t> &tail, uint8_t *slots, uint32_t capacity, const uint8_t *record)
+{
+    uint32_t tailIndex = tail.load(std::memory_order_relaxed);  // Only the producer writes the tail
+    bool retval = tailIndex - head.load(std::memory_order_acquire) < capacity;
+    if (retval) {
+        std::memcpy(slots + SLOT_SIZE * (tailIndex & (capacity - 1)), record, SLOT_SIZE);
+        tail.store(tailIndex + 1, std::memory_order_release);  // Publishes the record
+    }
+    return retval;
+}
+
+// Pops an encoded record from a ring, returning false if the ring is empty
+static bool pop(std::atomic<uint32_t> &head, std::atomic<uint32_t> &tail, const uint8_t *slots, uint32_t capacity, uint8_t *record)
+{
+    uint32_t headIndex = head.load(std::memory_order_relaxed);  // Only the consumer writes the head
+    bool retval = headIndex != tail.load(std::memory_order_acquire);
+    if (retval) {
+        std::memcpy(record, slots + SLOT_SIZE * (headIndex & (capacity - 1)), SLOT_SIZE);
+        head.store(headIndex + 1, std::memory_order_release);  // Frees the slot
+    }
+    return retval;
+}
+
+// Private procedure used to map the shared memory, closing the given descriptor afterwards
+int GF2Ring::map(int fd, size_t size)
+{
+    int retval;
+    void *address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping remains valid after the descriptor is closed
+    if (address == MAP_FAILED) {
+        retval = ERROR_SHM;
+    } else {
+        shared_ = static_cast<Shared *>(address);
+        size_ = size;
+        retval = SUCCESS;
+    }
+    return retval;
+}
+
+// "GF2Ring" class constructor
+GF2Ring::GF2Ring() :
+    shared_(nullptr),
+    size_(0),
+    capacity_(0),
+    name_(),
+    owner_(false)
+{
+}
+
+// "GF2Ring" class destructor
+GF2Ring::~GF2Ring()
+{
+    close();
+}
+
+// Returns the capacity of each ring, or zero if not open
+uint32_t GF2Ring::capacity() const
+{
+    return capacity_;
+}
+
+// Returns true if the rings are open
+bool GF2Ring::isOpen() const
+{
+    return shared_ != nullptr;
+}
+
+// Attaches to the rings created by the device owner under the given name, as a client
+int GF2Ring::attach(const std::string &name)
+{
+    int retval;
+    if (isOpen()) {  // Just in case the calling algorithm tries to attach twice
+        retval = SUCCESS;
+    } else {
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        struct stat status;
+        if (fd < 0) {
+            retval = ERROR_SHM;
+        } else if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(Shared)) {
+            ::close(fd);
+            retval = ERROR_FORMAT;
+        } else {
+            retval = map(fd, static_cast<size_t>(status.st_size));
+            uint32_t capacity = retval == SUCCESS ? shared_->capacity : 0;  // Read once, and validated before use
+            if (retval == SUCCESS && (shared_->magic != RING_MAGIC || shared_->version != RING_VERSION || capacity < CAPACITY_MIN || capacity > CAPACITY_MAX || (capacity & (capacity - 1)) != 0 || sizeof(Shared) + 2 * SLOT_SIZE * capacity > size_)) {
+                munmap(shared_, size_);
+                shared_ = nullptr;
+                retval = ERROR_FORMAT;
+            } else if (retval == SUCCESS) {
+                capacity_ = capacity;
+                name_ = name;
+                owner_ = false;
+            }
+        }
+    }
+    return retval;
+}
+
+// Detaches from the rings, also removing the shared memory if this is the owner
+void GF2Ring::close()
+{
+    if (isOpen()) {
+        munmap(shared_, size_);
+        if (owner_) {
+            shm_unlink(name_.c_str());
+        }
+        shared_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+        name_.clear();
+        owner_ = false;
+    }
+}
+
+// Creates the rings under the given name (e.g., "/gf2ring"), as the owner of the devices
+// The capacity must be a power of two between "CAPACITY_MIN" [2] and "CAPACITY_MAX" [65536]
+int GF2Ring::create(const std::string &name, uint32_t capacity)
+{
+    int retval;
+    if (isOpen()) {
+        retval = SUCCESS;
+    } else if (capacity < CAPACITY_MIN || capacity > CAPACITY_MAX || (capacity & (capacity - 1)) != 0) {
+        retval = ERROR_FORMAT;
+    } else {
+        shm_unlink(name.c_str());  // Removes a stale segment left by a previous owner
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+        size_t size = sizeof(Shared) + 2 * SLOT_SIZE * capacity;
+        if (fd < 0) {
+            retval = ERROR_SHM;
+        } else if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            shm_unlink(name.c_str());
+            retval = ERROR_SHM;
+        } else {
+            retval = map(fd, size);
+            if (retval == SUCCESS) {
+                new (shared_) Shared();  // The indexes are constructed in place, as zero
+                shared_->version = RING_VERSION;
+                shared_->capacity = capacity;
+                capacity_ = capacity;
+                std::atomic_thread_fence(std::memory_order_release);
+                shared_->magic = RING_MAGIC;  // Written last, so that a client never attaches to a partially initialized segment
+                name_ = name;
+                owner_ = true;
+            } else {
+                shm_unlink(name.c_str());
+            }
+        }
+    }
+    return retval;
+}
+
+// Pops a completion, as the client, returning false if there is none
+bool GF2Ring::popCompletion(GF2Protocol::Response &response)
+{
+    uint8_t record[SLOT_SIZE];
+    uint8_t *slots = reinterpret_cast<uint8_t *>(shared_ + 1) + SLOT_SIZE * capacity_;
+    return pop(shared_->completionHead, shared_->completionTail, slots, capacity_, record) && GF2Protocol::decodeResponse(record, response);
+}
+
+// Pops a request, as the owner, returning false if there is none
+// A malformed request is still returned, with "OPNONE" [0x00] as its opcode and the identifier found in the record, so that the owner can complete it with an error
+bool GF2Ring::popRequest(GF2Protocol::Request &request)
+{
+    uint8_t record[SLOT_SIZE];
+    uint8_t *slots = reinterpret_cast<uint8_t *>(shared_ + 1);
+    bool retval = pop(shared_->requestHead, shared_->requestTail, slots, capacity_, record);
+    if (retval && !GF2Protocol::decodeRequest(record, request)) {
+        request = {GF2Protocol::OPNONE, static_cast<uint32_t>(record[7] << 24 | record[6] << 16 | record[5] << 8 | record[4]), 0, 0, 0};  // The identifier is read as in GF2Protocol::decodeRequest()
+    }
+    return retval;
+}
+
+// Pushes a completion, as the owner, returning false if the ring is full
+bool GF2Ring::pushCompletion(const GF2Protocol::Response &response)
+{
+    uint8_t record[SLOT_SIZE];
+    GF2Protocol::encodeResponse(response, record);
+    uint8_t *slots = reinterpret_cast<uint8_t *>(shared_ + 1) + SLOT_SIZE * capacity_;
+    return push(shared_->completionHead, shared_->completionTail, slots, capacity_, record);
+}
+
+// Pushes a request, as the client, returning false if the ring is full
+bool GF2Ring::pushRequest(const GF2Protocol::Request &request)
+{
+    uint8_t record[SLOT_SIZE];
+    GF2Protocol::encodeRequest(request, record);
+    uint8_t *slots = reinterpret_cast<uint8_t *>(shared_ + 1);
+    return push(shared_->requestHead, shared_->requestTail, slots, capacity_, record);
+}
@@ -0,0 +1,73 @@
+/* GF2 ring class - Version 1.0.0
+   Requires GF2 protocol class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This library is free software: you can redistribute it and/or modify it
+   under the terms of the GNU Lesser General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or (at your
+   option) any later version.
+
+   This library is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+   License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this library.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+#ifndef GF2RING_H
+#define GF2RING_H
+
+// Includes
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "gf2protocol.h"
+
+// Pair of single-producer, single-consumer rings in POSIX shared memory, carrying encoded GF2 protocol requests and their completions
+// The owner of the devices creates the rings, and a single client attaches to them
+// Neither side makes any system calls while pushing or popping, as both only rely on atomic indexes shared between processes
+class GF2Ring
+{
+private:
+    struct Shared;
+
+    Shared *shared_;
+    size_t size_;
+    uint32_t capacity_;  // Capacity of each ring, kept privately, since the shared memory is writable by the other side
+    std::string name_;
+    bool owner_;
+
+    int map(int fd, size_t size);
+
+public:
+    // Class definitions
+    static const int SUCCESS = 0;       // Returned by attach() or create() if successful
+    static const int ERROR_SHM = 1;     // Returned by attach() or create() if the shared memory could not be opened or mapped
+    static const int ERROR_FORMAT = 2;  // Returned by attach() if the shared memory does not hold a compatible ring, or by create() if the capacity is invalid
+
+    // Limits applicable to create()
+    static const uint32_t CAPACITY_MIN = 2;      // Minimum capacity of each ring
+    static const uint32_t CAPACITY_MAX = 65536;  // Maximum capacity of each ring
+
+    GF2Ring();
+    ~GF2Ring();
+
+    uint32_t capacity() const;
+    bool isOpen() const;
+
+    int attach(const std::string &name);
+    void close();
+    int create(const std::string &name, uint32_t capacity);
+    bool popCompletion(GF2Protocol::Response &response);
+    bool popRequest(GF2Protocol::Request &request);
+    bool pushCompletion(const GF2Protocol::Response &response);
+    bool pushRequest(const GF2Protocol::Request &request);
+};
+
+#endif  // GF2RING_H
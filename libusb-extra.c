@@ -1,4 +1,4 @@
-/* Extra functions for libusb - Version 1.0.3
+/* Extra functions for libusb - Version 1.1.0
    Copyright (c) 2018-2021 Samuel Lourenço
 
    This library is free software: you can redistribute it and/or modify it
@@ -22,6 +22,54 @@
 #include <string.h>
 #include "libusb-extra.h"
 
+// Opens the device with matching VID and PID, located at the given bus number and address (added in version 1.1.0)
+// Unlike libusb_open_device_with_vid_pid_serial(), this function does not open any other device in order to find the intended one
+libusb_device_handle *libusb_open_device_with_vid_pid_bus_address(libusb_context *context, uint16_t vid, uint16_t pid, uint8_t bus, uint8_t address)
+{
+    libusb_device **devs;
+    libusb_device_handle *devhandle = NULL;
+    if (libusb_get_device_list(context, &devs) >= 0) {  // If the device list is retrieved
+        libusb_device *dev;
+        size_t devcounter = 0;
+        while ((dev = devs[devcounter++]) != NULL) {  // Walk through all the devices
+            struct libusb_device_descriptor desc;
+            if (libusb_get_bus_number(dev) == bus && libusb_get_device_address(dev) == address && libusb_get_device_descriptor(dev, &desc) == 0 && desc.idVendor == vid && desc.idProduct == pid) {  // If the device is located at the given bus and address, and both PID and VID match
+                if (libusb_open(dev, &devhandle) != 0) {  // Open the device. In case of failure
+                    devhandle = NULL;  // Set device handle value to null pointer
+                }
+                break;  // No other device can be located at the same bus and address
+            }
+        }
+        libusb_free_device_list(devs, 1);  // Free device list
+    }
+    return devhandle;  // Return device handle (or null pointer if no matching device was found)
+}
+
+// Opens the device with matching VID and PID, located at the given bus number and port path, as reported by libusb_get_port_numbers() (added in version 1.1.0)
+// As with the previous function, no other device is opened in the process
+libusb_device_handle *libusb_open_device_with_vid_pid_path(libusb_context *context, uint16_t vid, uint16_t pid, uint8_t bus, const uint8_t *ports, int nports)
+{
+    libusb_device **devs;
+    libusb_device_handle *devhandle = NULL;
+    if (libusb_get_device_list(context, &devs) >= 0) {  // If the device list is retrieved
+        libusb_device *dev;
+        size_t devcounter = 0;
+        while ((dev = devs[devcounter++]) != NULL) {  // Walk through all the devices
+            uint8_t devports[7];  // As per the USB 3.0 specification, the maximum hub depth is limited to 7
+            int ndevports = libusb_get_port_numbers(dev, devports, (int)sizeof(devports));
+            struct libusb_device_descriptor desc;
+            if (libusb_get_bus_number(dev) == bus && ndevports == nports && memcmp(devports, ports, (size_t)nports) == 0 && libusb_get_device_descriptor(dev, &desc) == 0 && desc.idVendor == vid && desc.idProduct == pid) {  // If the device is located at the given bus and port path, and both PID and VID match
+                if (libusb_open(dev, &devhandle) != 0) {  // Open the device. In case of failure
+                    devhandle = NULL;  // Set device handle value to null pointer
+                }
+                break;  // No other device can be located at the same bus and port path
+            }
+        }
+        libusb_free_device_list(devs, 1);  // Free device list
+    }
+    return devhandle;  // Return device handle (or null pointer if no matching device was found)
+}
+
 // Opens the device with matching VID, PID and serial number
 libusb_device_handle *libusb_open_device_with_vid_pid_serial(libusb_context *context, uint16_t vid, uint16_t pid, unsigned char *serial)
 {
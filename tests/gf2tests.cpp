@@ -0,0 +1,422 @@
+/* GF2 tests - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later and CP2130 simulator class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "cp2130sim.h"
+#include "gf2calibration.h"
+#include "gf2device.h"
+#include "gf2linearization.h"
+#include "gf2metrics.h"
+#include "gf2protocol.h"
+
+// Definitions
+const double FQUANTUM = 268435456;  // Quantum related to the 28-bit frequency resolution of the AD9834 waveform generator
+const double MCLK = 80000;          // 80MHz clock (nominal)
+
+// Test case, run when its name is given via the command line
+struct Test {
+    const char *name;
+    void (*function)();
+};
+
+static int failures = 0;
+
+// Reports a failed check, along with its description
+static void check(bool condition, const std::string &description)
+{
+    if (!condition) {
+        ++failures;
+        std::cerr << "Failed: " << description << "\n";
+    }
+}
+
+// Returns the given bytes as a string of hexadecimal values
+static std::string hexString(const std::vector<uint8_t> &bytes)
+{
+    std::ostringstream stream;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        stream << (i > 0 ? " " : "") << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(bytes[i]);
+    }
+    return stream.str();
+}
+
+// Reports a failed check if the given bytes differ from the expected ones
+static void checkBytes(const std::vector<uint8_t> &bytes, const std::vector<uint8_t> &expected, const std::string &description)
+{
+    check(bytes == expected, description + " (got \"" + hexString(bytes) + "\", expected \"" + hexString(expected) + "\")");
+}
+
+// Reports a failed check if any errors were reported
+static void checkErrors(int errcnt, const std::string &errstr, const std::string &description)
+{
+    check(errcnt == 0, description + " (" + errstr + ")");
+}
+
+// Returns the frequency (in KHz) that corresponds exactly to the given tuning word, assuming an ideal master clock
+static float frequency(uint32_t code)
+{
+    return static_cast<float>(code * MCLK / FQUANTUM);
+}
+
+// Attaches a simulated GF2 device
+static void openSimulated(CP2130Sim &simulator, GF2Device &device)
+{
+    simulator.setUSBConfig({GF2Device::VID, GF2Device::PID, 0x01, 0x00, 0x32, CP2130::PMBUSREGEN, CP2130::PRIOWRITE});
+    check(device.open(&simulator) == GF2Device::SUCCESS, "open() attaches the simulator");
+}
+
+// Only the OTP ROM blocks that differ are written, and locked fields are protected (CP2130::updatePROMConfig())
+static void testPROMUpdate()
+{
+    int errcnt = 0;
+    std::string errstr;
+    CP2130Sim simulator;
+    CP2130 cp2130;
+    cp2130.open(&simulator);
+    CP2130::PROMConfig current = cp2130.getPROMConfig(errcnt, errstr);
+    checkErrors(errcnt, errstr, "getPROMConfig() succeeds");
+    check(current.changedFields(current) == 0x0000, "changedFields() is empty for identical configurations");
+    CP2130::PROMConfig config = current;
+    config.setVID(0x1234);
+    check(current.changedFields(config) == CP2130::LWVID, "changedFields() reports the vendor ID");
+    config.setSerialDesc(u"GF2TEST", errcnt, errstr);
+    check(current.changedFields(config) == (CP2130::LWVID | CP2130::LWSER), "changedFields() reports the vendor ID and the serial descriptor");
+    size_t changedBlocks = 0;
+    for (size_t i = 0; i < CP2130::PROM_BLOCKS; ++i) {
+        changedBlocks += std::memcmp(current.blocks[i], config.blocks[i], CP2130::PROM_BLOCK_SIZE) != 0;
+    }
+    uint64_t before = simulator.getTransferCount();
+    cp2130.updatePROMConfig(config, errcnt, errstr);
+    checkErrors(errcnt, errstr, "updatePROMConfig() succeeds");
+    check(simulator.getTransferCount() - before == CP2130::PROM_BLOCKS + changedBlocks, "updatePROMConfig() reads every block, but only writes the blocks that differ");
+    check(cp2130.getPROMConfig(errcnt, errstr) == config, "updatePROMConfig() writes the given configuration");
+    CP2130::PROMConfig locked = config;
+    locked.setLockWord(static_cast<uint16_t>(config.getLockWord() & ~CP2130::LWVID));  // A cleared lock bit locks the corresponding field
+    cp2130.updatePROMConfig(locked, errcnt, errstr);
+    checkErrors(errcnt, errstr, "updatePROMConfig() may lock fields");
+    CP2130::PROMConfig modified = locked;
+    modified.setVID(0x4321);
+    int errcntLocked = 0;
+    std::string errstrLocked;
+    before = simulator.getTransferCount();
+    cp2130.updatePROMConfig(modified, errcntLocked, errstrLocked);
+    check(errcntLocked == 1 && errstrLocked.find("locked") != std::string::npos, "updatePROMConfig() refuses to modify a locked field");
+    check(simulator.getTransferCount() - before == CP2130::PROM_BLOCKS, "updatePROMConfig() writes nothing if it refuses");
+    CP2130::PROMConfig unlocked = locked;
+    unlocked.setLockWord(CP2130::LWALL);
+    int errcntUnlocked = 0;
+    std::string errstrUnlocked;
+    cp2130.updatePROMConfig(unlocked, errcntUnlocked, errstrUnlocked);
+    check(errcntUnlocked == 1 && errstrUnlocked.find("unlock") != std::string::npos, "updatePROMConfig() refuses to unlock a field");
+    check(cp2130.getPROMConfig(errcnt, errstr) == locked, "refused updates leave the OTP ROM untouched");
+    checkErrors(errcnt, errstr, "no other errors are reported");
+}
+
+// A transaction writes each chip select once, with the expected SPI words (GF2Device::Transaction::commit())
+static void testTransaction()
+{
+    int errcnt = 0;
+    std::string errstr;
+    CP2130Sim simulator;
+    GF2Device device;
+    openSimulated(simulator, device);
+    device.clear(errcnt, errstr);  // Leaves all registers at zero and the waveform sinusoidal, in a known state
+    GF2Device::Transaction transaction(device);
+    transaction.setFrequency(1, 1000, errcnt, errstr);
+    transaction.setFrequency(1, frequency(0x00100000), errcnt, errstr);  // Supersedes the step above, and only changes the 14 MSBs
+    transaction.setPhase(1, 90);
+    transaction.setAmplitude(8, errcnt, errstr);
+    transaction.setTriangleWave();
+    transaction.selectFrequency(1);
+    transaction.selectPhase(1);
+    check(!transaction.isEmpty(), "isEmpty() returns false if steps are pending");
+    uint64_t before = simulator.getTransferCount();
+    transaction.commit(errcnt, errstr);
+    checkErrors(errcnt, errstr, "commit() succeeds");
+    check(transaction.isEmpty(), "commit() discards the steps");
+    checkBytes(simulator.getLastSPIWrite(0), {
+        0x22, 0x02,  // Control word: B28 = 1, PIN/SW = 1, MODE = 1 (triangular waveform)
+        0x12, 0x02,  // Control word: B28 = 0, HLB = 1, so that only the 14 MSBs follow
+        0x80, 0x40,  // FREQ1 MSBs
+        0xe4, 0x00   // PHASE1 set to 1024 (90 degrees)
+    }, "commit() writes the AD9834 registers in one transfer");
+    checkBytes(simulator.getLastSPIWrite(1), {0x0f, 0xfc}, "commit() writes the AD5310 code");
+    check((simulator.getGPIOs() & (CP2130::BMGPIO4 | CP2130::BMGPIO5)) == (CP2130::BMGPIO4 | CP2130::BMGPIO5), "commit() sets FSEL and PSEL");
+    check(simulator.getTransferCount() - before <= 9, "commit() takes at most nine transfers");
+    before = simulator.getTransferCount();
+    transaction.commit(errcnt, errstr);
+    check(simulator.getTransferCount() == before, "committing an empty transaction does nothing");
+}
+
+// Only the half of a tuning word that changes is written, with B28 cleared (GF2Device::setFrequency())
+static void testHalfWrites()
+{
+    int errcnt = 0;
+    std::string errstr;
+    CP2130Sim simulator;
+    GF2Device device;
+    openSimulated(simulator, device);
+    device.setFrequency(0, frequency(0x00000001), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x40, 0x01, 0x40, 0x00}, "while the control word is unknown, the full write leaves it untouched");
+    device.setTriangleWave(errcnt, errstr);
+    device.setFrequency(0, frequency(0x00000002), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x02, 0x02, 0x40, 0x02}, "once the control word is written, short writes keep the waveform");
+    device.clear(errcnt, errstr);
+    device.setFrequency(0, frequency(0x00000001), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x02, 0x00, 0x40, 0x01}, "B28 is cleared before writing the 14 LSBs alone");
+    device.setFrequency(0, frequency(0x00000002), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x40, 0x02}, "further LSB changes take a single word");
+    device.setFrequency(0, frequency(0x00004002), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x12, 0x00, 0x40, 0x01}, "HLB is set before writing the 14 MSBs alone");
+    device.setFrequency(0, frequency(0x00008003), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x22, 0x00, 0x40, 0x03, 0x40, 0x02}, "B28 is set again if both halves change");
+    device.setFrequency(1, frequency(0x00000005), errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x02, 0x00, 0x80, 0x05}, "each register keeps its own tuning word");
+    device.setTriangleWave(errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(0), {0x22, 0x02}, "setTriangleWave() writes the control word with B28 set");
+    device.close();
+    checkBytes(simulator.getLastSPIWrite(0), {0x22, 0x02}, "close() leaves B28 set");
+    checkErrors(errcnt, errstr, "no errors are reported");
+}
+
+// A profile restores the state it was saved from, and the registers already in place are not written (GF2Device::saveProfile() and GF2Device::restoreProfile())
+static void testProfile()
+{
+    int errcnt = 0;
+    std::string errstr;
+    CP2130Sim simulator;
+    GF2Device device;
+    openSimulated(simulator, device);
+    device.setupChannel0(errcnt, errstr);
+    device.setupChannel1(errcnt, errstr);
+    int errcntEarly = 0;
+    std::string errstrEarly;
+    device.saveProfile(errcntEarly, errstrEarly);
+    check(errcntEarly == 1, "saveProfile() fails while the registers are unknown");
+    device.clear(errcnt, errstr);
+    device.setFrequency(0, 1000, errcnt, errstr);
+    device.setFrequency(1, 2000, errcnt, errstr);
+    device.setPhase(1, 90, errcnt, errstr);
+    device.setAmplitude(5, errcnt, errstr);
+    device.setTriangleWave(errcnt, errstr);
+    device.selectFrequency(1, errcnt, errstr);
+    std::vector<uint8_t> profile = device.saveProfile(errcnt, errstr);
+    check(profile.size() == GF2Device::PROFILE_SIZE, "saveProfile() returns \"PROFILE_SIZE\" bytes");
+    uint16_t gpios = simulator.getGPIOs();
+    device.setFrequency(0, 3000, errcnt, errstr);
+    device.setAmplitude(1, errcnt, errstr);
+    device.setSineWave(errcnt, errstr);
+    device.selectFrequency(0, errcnt, errstr);
+    device.restoreProfile(profile, errcnt, errstr);
+    check(device.saveProfile(errcnt, errstr) == profile, "restoreProfile() restores the saved state");
+    check(simulator.getGPIOs() == gpios, "restoreProfile() restores the control lines");
+    uint64_t before = simulator.getTransferCount();
+    device.restoreProfile(profile, errcnt, errstr);
+    check(simulator.getTransferCount() - before == 3, "restoring the profile in place only sets the SPI modes and the control lines");
+    CP2130Sim otherSimulator;
+    GF2Device other;
+    openSimulated(otherSimulator, other);
+    other.restoreProfile(profile, errcnt, errstr);
+    check(other.saveProfile(errcnt, errstr) == profile, "restoreProfile() also works on a device that was just opened");
+    check(otherSimulator.getGPIOs() == gpios, "restoreProfile() sets the same control lines on another device");
+    checkErrors(errcnt, errstr, "no errors are reported");
+    std::vector<uint8_t> invalid = profile;
+    invalid[0] = 0x00;
+    int errcntInvalid = 0;
+    std::string errstrInvalid;
+    other.restoreProfile(invalid, errcntInvalid, errstrInvalid);
+    check(errcntInvalid == 1, "restoreProfile() rejects an invalid profile");
+}
+
+// Reference implementation of the calibrated tuning word, found by a linear search over the correction points
+static uint32_t referenceCode(float frequency, double mclkError, const std::vector<GF2Calibration::Point> &points)
+{
+    double correction = points.empty() ? 0 : points.front().error;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (points[i].frequency <= frequency) {
+            correction = points[i].error;
+            if (i + 1 < points.size() && points[i + 1].frequency > frequency) {
+                correction = points[i].error + (points[i + 1].error - points[i].error) * (frequency - points[i].frequency) / (points[i + 1].frequency - points[i].frequency);
+            }
+        }
+    }
+    return static_cast<uint32_t>(frequency * (FQUANTUM / (MCLK * (1 + mclkError / 1000000)) / (1 + correction / 1000000)) + 0.5);
+}
+
+// The segment table gives the same tuning words as a linear search, including within bins holding several points (GF2Calibration)
+static void testCalibration()
+{
+    int errcnt = 0;
+    std::string errstr;
+    GF2Calibration calibration;
+    check(calibration.isIdentity(), "the calibration is initially the identity");
+    check(calibration.frequencyCode(frequency(0x00400000)) == 0x00400000, "the identity gives the nominal tuning word");
+    std::vector<GF2Calibration::Point> points = {{0, 0}, {10, 1000}, {20, 0}, {20.01f, -50}, {20.02f, 80}, {15000, 25}, {40000, -10}};  // Several points fall within the same bin
+    calibration.setPoints(points, errcnt, errstr);
+    checkErrors(errcnt, errstr, "setPoints() accepts the points");
+    check(calibration.frequencyCode(10) == 33521, "the correction at a point is applied in full");
+    calibration.setMCLKError(12.5, errcnt, errstr);
+    checkErrors(errcnt, errstr, "setMCLKError() accepts the error");
+    bool matches = true;
+    for (int i = 0; i <= 400000; ++i) {
+        float f = i % 2 == 0 ? i / 10.0f : static_cast<float>(i % 4000) / 100;  // Alternates between the full range and the region of dense points
+        matches = matches && calibration.frequencyCode(f) == referenceCode(f, 12.5, points);
+    }
+    check(matches, "frequencyCode() matches the linear search");
+    int errcntInvalid = 0;
+    std::string errstrInvalid;
+    calibration.setPoints({{10, 20000}}, errcntInvalid, errstrInvalid);
+    check(errcntInvalid == 1, "setPoints() rejects errors beyond the limit");
+}
+
+// The DAC code depends on the frequency band, and the device applies the band of the active frequency (GF2Linearization)
+static void testLinearization()
+{
+    int errcnt = 0;
+    std::string errstr;
+    GF2Linearization linearization;
+    check(linearization.isIdentity() && !linearization.isFrequencyDependent(), "the linearization is initially the identity");
+    check(linearization.amplitudeCode(8) == 1023 && linearization.amplitudeCode(4) == 512, "the identity gives the nominal code");
+    linearization.setPoints({{0, 0, 0}, {0, 1023, 8}, {40000, 0, 0}, {40000, 1023, 4}}, errcnt, errstr);  // The output halves across the frequency range
+    checkErrors(errcnt, errstr, "setPoints() accepts the points");
+    check(linearization.isFrequencyDependent(), "isFrequencyDependent() returns true for measurements at several frequencies");
+    check(linearization.amplitudeCode(2, 0) == 259, "the lowest band is interpolated at its center");
+    check(linearization.amplitudeCode(2, 39000) == 509, "the highest band is interpolated at its center");
+    float amplitudes[] = {0, 1, 2, 4, 8};
+    uint16_t codes[5];
+    linearization.amplitudeCodes(amplitudes, 5, 39000, codes);
+    bool matches = true;
+    for (size_t i = 0; i < 5; ++i) {
+        matches = matches && codes[i] == linearization.amplitudeCode(amplitudes[i], 39000);
+    }
+    check(matches, "amplitudeCodes() matches amplitudeCode()");
+    CP2130Sim simulator;
+    GF2Device device;
+    openSimulated(simulator, device);
+    device.setLinearization(linearization);
+    device.clear(errcnt, errstr);
+    device.setFrequency(1, 39000, errcnt, errstr);
+    device.setAmplitude(2, errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(1), {0x04, 0x0c}, "setAmplitude() applies the band of FREQ0 while it is selected");
+    device.selectFrequency(1, errcnt, errstr);
+    device.setAmplitude(2, errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(1), {0x07, 0xf4}, "setAmplitude() applies the band of FREQ1 once it is selected");
+    GF2Device::Transaction transaction(device);
+    transaction.setAmplitude(2, errcnt, errstr);
+    transaction.selectFrequency(0);
+    transaction.commit(errcnt, errstr);
+    checkBytes(simulator.getLastSPIWrite(1), {0x04, 0x0c}, "a transaction applies the band of the frequency it selects");
+    checkErrors(errcnt, errstr, "no errors are reported");
+}
+
+// Generator values are only exported once known, and follow the writes made through the device (GF2Metrics and GF2Device::getRegisterState())
+static void testMetrics()
+{
+    int errcnt = 0;
+    std::string errstr;
+    CP2130Sim simulator;
+    GF2Device device;
+    openSimulated(simulator, device);
+    GF2Metrics metrics;
+    metrics.addDevice("GF2-\"1\"", &device);
+    std::string exposition = metrics.getExposition();
+    check(exposition.find("gf2_device_open{serial=\"GF2-\\\"1\\\"\"} 1") != std::string::npos, "getExposition() escapes the serial number");
+    check(exposition.find("gf2_frequency_hertz{") == std::string::npos && exposition.find("gf2_waveform_triangular{") == std::string::npos, "getExposition() leaves out values that are not known");
+    device.clear(errcnt, errstr);
+    device.setTriangleWave(errcnt, errstr);
+    device.setAmplitudeCode(512, errcnt, errstr);
+    device.setFrequencyAndPhase(frequency(0x00400000), 90, errcnt, errstr);  // Written to FREQ1 and PHASE1, since FREQ0 and PHASE0 were active
+    checkErrors(errcnt, errstr, "the device is set up");
+    GF2Device::RegisterState state = device.getRegisterState();
+    check(state.frequencyKnown[1] && state.frequencies[1] == 1250 && state.phaseKnown[1] && state.phases[1] == 90, "getRegisterState() returns the frequency and phase written");
+    check(state.fselKnown && state.fsel && state.pselKnown && state.psel, "getRegisterState() returns the selections set");
+    exposition = metrics.getExposition();
+    check(exposition.find("gf2_frequency_hertz{serial=\"GF2-\\\"1\\\"\",register=\"1\"} 1250000\n") != std::string::npos, "getExposition() exports the frequency of FREQ1");
+    check(exposition.find("gf2_phase_degrees{serial=\"GF2-\\\"1\\\"\",register=\"1\"} 90\n") != std::string::npos, "getExposition() exports the phase of PHASE1");
+    check(exposition.find("gf2_frequency_selected{serial=\"GF2-\\\"1\\\"\"} 1\n") != std::string::npos, "getExposition() exports the frequency selection");
+    check(exposition.find("gf2_amplitude_code{serial=\"GF2-\\\"1\\\"\"} 512\n") != std::string::npos, "getExposition() exports the amplitude code");
+    check(exposition.find("gf2_waveform_triangular{serial=\"GF2-\\\"1\\\"\"} 1\n") != std::string::npos, "getExposition() exports the waveform");
+    device.reset(errcnt, errstr);
+    check(metrics.getExposition().find("gf2_amplitude_code{") == std::string::npos, "reset() makes the values unknown again");
+}
+
+// Requests, responses and device lists survive encoding and decoding, and foreign data is rejected (GF2Protocol)
+static void testProtocol()
+{
+    GF2Protocol::Request request = {GF2Protocol::OPFREQ, 0xdeadbeef, 3, 1, 1234.5f};
+    uint8_t buffer[GF2Protocol::REQUEST_SIZE];
+    GF2Protocol::encodeRequest(request, buffer);
+    check(buffer[0] == 0x47 && buffer[1] == 0x32 && buffer[2] == GF2Protocol::VERSION && buffer[3] == GF2Protocol::OPFREQ, "encodeRequest() starts with the magic number, version and opcode");
+    check(buffer[4] == 0xef && buffer[5] == 0xbe && buffer[6] == 0xad && buffer[7] == 0xde, "encodeRequest() stores the identifier in little-endian byte order");
+    GF2Protocol::Request decodedRequest;
+    check(GF2Protocol::decodeRequest(buffer, decodedRequest) && decodedRequest == request, "decodeRequest() returns the encoded request");
+    buffer[2] = GF2Protocol::VERSION + 1;
+    check(!GF2Protocol::decodeRequest(buffer, decodedRequest), "decodeRequest() rejects other versions");
+    GF2Protocol::Response response = {GF2Protocol::OPSTATUS, 42, GF2Protocol::STIO, 17, GF2Protocol::STBMCLOCK | GF2Protocol::STBMPSEL};
+    uint8_t header[GF2Protocol::RESPONSE_SIZE];
+    GF2Protocol::encodeResponse(response, header);
+    GF2Protocol::Response decodedResponse;
+    check(GF2Protocol::decodeResponse(header, decodedResponse) && decodedResponse == response, "decodeResponse() returns the encoded response");
+    header[0] = 0x00;
+    check(!GF2Protocol::decodeResponse(header, decodedResponse), "decodeResponse() rejects a wrong magic number");
+    std::vector<GF2Protocol::DeviceEntry> entries = {{0, true, "GF2-0001"}, {1, false, ""}, {7, true, "A longer serial number"}};
+    check(GF2Protocol::decodeDeviceList(GF2Protocol::encodeDeviceList(entries)) == entries, "decodeDeviceList() returns the encoded entries");
+    check(GF2Protocol::decodeDeviceList(std::vector<uint8_t>(1, 0x05)).empty(), "decodeDeviceList() rejects a truncated list");
+}
+
+// Test cases
+const Test TESTS[] = {
+    {"prom", testPROMUpdate},
+    {"transaction", testTransaction},
+    {"halfwrites", testHalfWrites},
+    {"profile", testProfile},
+    {"calibration", testCalibration},
+    {"linearization", testLinearization},
+    {"metrics", testMetrics},
+    {"protocol", testProtocol}
+};
+
+int main(int argc, char **argv)
+{
+    int err_level = EXIT_SUCCESS;
+    bool found = false;
+    for (const Test &test : TESTS) {
+        if (argc < 2 || std::strcmp(argv[1], test.name) == 0) {  // All test cases are run if none is given
+            test.function();
+            found = true;
+        }
+    }
+    if (!found) {
+        std::cerr << "Error: Unknown test case \"" << argv[1] << "\".\n";
+        err_level = EXIT_FAILURE;
+    } else if (failures > 0) {
+        std::cerr << failures << " check(s) failed.\n";
+        err_level = EXIT_FAILURE;
+    }
+    return err_level;
+}
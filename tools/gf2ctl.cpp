@@ -0,0 +1,339 @@
+/* GF2 control tool - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later and CP2130 simulator class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "cp2130sim.h"
+#include "gf2device.h"
+
+// Definitions
+const float SWEEP_EPSILON = 0.001f;  // Tolerance, in steps, so that a "stop" frequency lying on a step is not lost to rounding
+
+// State kept during a session, so that the device is opened only once
+struct Session {
+    GF2Device device;
+    CP2130Sim *simulator;     // If not null, the session runs against this simulator instead of real hardware
+    std::string serial;       // Serial number of the device to open, or empty to open the first one found
+    std::string calibration;  // Calibration file, or empty to use the nominal master clock
+    bool timing;              // If true, the time taken by each command is printed
+};
+
+// Parses a floating point argument, returning false if it is missing or invalid
+static bool parseFloat(const std::vector<std::string> &args, size_t index, float &value)
+{
+    bool retval = false;
+    if (index < args.size()) {
+        char *end;
+        value = std::strtof(args[index].c_str(), &end);
+        retval = end != args[index].c_str() && *end == '\0';
+    }
+    return retval;
+}
+
+// Parses a frequency or phase selection argument ("0" or "1"), returning false if it is missing or invalid
+static bool parseSelection(const std::vector<std::string> &args, size_t index, bool &value)
+{
+    bool retval = false;
+    if (index < args.size() && (args[index] == "0" || args[index] == "1")) {
+        value = args[index] == "1";
+        retval = true;
+    }
+    return retval;
+}
+
+// Opens the device for the session, if not already open, and sets up both SPI channels
+static void openDevice(Session &session, int &errcnt, std::string &errstr)
+{
+    if (!session.device.isOpen()) {
+        int result = session.simulator != nullptr ? session.device.open(session.simulator) : session.device.open(session.serial);
+        if (result == GF2Device::SUCCESS) {
+            session.device.setupChannel0(errcnt, errstr);
+            session.device.setupChannel1(errcnt, errstr);
+            if (!session.calibration.empty()) {
+                std::u16string serial = session.device.getSerialDesc(errcnt, errstr);
+                session.device.setCalibration(GF2Calibration::load(session.calibration, std::string(serial.begin(), serial.end()), errcnt, errstr));
+            }
+        } else {
+            ++errcnt;
+            if (result == GF2Device::ERROR_INIT) {
+                errstr += "Could not initialize libusb.\n";
+            } else if (result == GF2Device::ERROR_NOT_FOUND) {
+                errstr += "Device not found.\n";
+            } else {
+                errstr += "Device is currently unavailable.\n";
+            }
+        }
+    }
+}
+
+// Sweeps the frequency from "start" to "stop", dwelling "dwell" milliseconds at each step
+// Each step writes the inactive frequency register and then selects it, so that the output never goes through a partially written tuning word
+static void sweep(Session &session, float start, float stop, float step, float dwell, int &errcnt, std::string &errstr)
+{
+    bool fsel = session.device.getFrequencySelection(errcnt, errstr);
+    float direction = stop >= start ? 1 : -1;
+    size_t steps = static_cast<size_t>(std::floor((stop - start) / (direction * step) + SWEEP_EPSILON)) + 1;  // The last step never goes past "stop"
+    int preverrcnt = errcnt;
+    for (size_t i = 0; i < steps && errcnt == preverrcnt; ++i) {
+        fsel = !fsel;
+        float frequency = start + direction * step * i;
+        session.device.setFrequency(fsel, direction * (frequency - stop) > 0 ? stop : frequency, errcnt, errstr);  // Guards against rounding
+        session.device.selectFrequency(fsel, errcnt, errstr);
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long>(dwell * 1000)));
+    }
+}
+
+// Executes a single command, returning false if the command is unknown or its arguments are invalid
+static bool execute(Session &session, const std::vector<std::string> &args, int &errcnt, std::string &errstr)
+{
+    const std::string &command = args[0];
+    bool retval = true;
+    bool sel;
+    float value, stop, step, dwell, divider;
+    if (command == "open") {
+        session.device.close();  // A different device may be opened mid-session
+        session.serial = args.size() > 1 ? args[1] : std::string();
+        openDevice(session, errcnt, errstr);
+    } else if (command == "close") {
+        session.device.close();
+    } else {
+        openDevice(session, errcnt, errstr);  // Every other command needs the device, which is opened on first use
+        if (errcnt > 0) {
+            // The device could not be opened, so the command is skipped
+        } else if (command == "clear" && args.size() == 1) {
+            session.device.clear(errcnt, errstr);
+        } else if (command == "freq" && parseSelection(args, 1, sel) && parseFloat(args, 2, value) && args.size() == 3) {
+            session.device.setFrequency(sel, value, errcnt, errstr);
+        } else if (command == "phase" && parseSelection(args, 1, sel) && parseFloat(args, 2, value) && args.size() == 3) {
+            session.device.setPhase(sel, value, errcnt, errstr);
+        } else if (command == "amp" && parseFloat(args, 1, value) && args.size() == 2) {
+            if (value < GF2Device::AMPLITUDE_MIN || value > GF2Device::AMPLITUDE_MAX) {
+                ++errcnt;
+                errstr += "Amplitude must be between 0 and 8.\n";
+            } else {
+                session.device.setAmplitude(value, errcnt, errstr);
+            }
+        } else if (command == "wave" && args.size() == 2 && (args[1] == "sine" || args[1] == "triangle")) {
+            if (args[1] == "sine") {
+                session.device.setSineWave(errcnt, errstr);
+            } else {
+                session.device.setTriangleWave(errcnt, errstr);
+            }
+        } else if (command == "fsel" && parseSelection(args, 1, sel) && args.size() == 2) {
+            session.device.selectFrequency(sel, errcnt, errstr);
+        } else if (command == "psel" && parseSelection(args, 1, sel) && args.size() == 2) {
+            session.device.selectPhase(sel, errcnt, errstr);
+        } else if (command == "start" && args.size() == 1) {
+            session.device.start(errcnt, errstr);
+        } else if (command == "stop" && args.size() == 1) {
+            session.device.stop(errcnt, errstr);
+        } else if (command == "sweep" && parseFloat(args, 1, value) && parseFloat(args, 2, stop) && parseFloat(args, 3, step) && parseFloat(args, 4, dwell) && args.size() == 5) {
+            if (value < GF2Device::FREQUENCY_MIN || value > GF2Device::FREQUENCY_MAX || stop < GF2Device::FREQUENCY_MIN || stop > GF2Device::FREQUENCY_MAX) {
+                ++errcnt;
+                errstr += "Frequency must be between 0 and 40000.\n";
+            } else if (step <= 0 || dwell < 0) {
+                ++errcnt;
+                errstr += "Step must be positive, and dwell time cannot be negative.\n";
+            } else {
+                sweep(session, value, stop, step, dwell, errcnt, errstr);
+            }
+        } else if (command == "measure" && parseFloat(args, 1, value) && parseFloat(args, 2, divider) && args.size() == 3) {
+            if (value < GF2Device::GATE_MIN || value > GF2Device::GATE_MAX || divider < 1 || divider > 65535) {
+                ++errcnt;
+                errstr += "Gate time must be between 1 and 10000, and divider must be between 1 and 65535.\n";
+            } else {
+                float frequency = session.device.measureFrequency(static_cast<uint16_t>(value), static_cast<uint16_t>(divider), errcnt, errstr);
+                if (errcnt == 0) {
+                    std::cout << std::fixed << std::setprecision(3) << frequency << " KHz" << std::endl;
+                }
+            }
+        } else if (command == "save" && args.size() == 2) {
+            std::vector<uint8_t> profile = session.device.saveProfile(errcnt, errstr);
+            if (errcnt == 0) {
+                std::ofstream file(args[1], std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char *>(profile.data()), static_cast<std::streamsize>(profile.size()));
+                file.close();
+                if (!file) {
+                    ++errcnt;
+                    errstr += "Could not write " + args[1] + ".\n";
+                }
+            }
+        } else if (command == "restore" && args.size() == 2) {
+            std::ifstream file(args[1], std::ios::binary);
+            if (!file) {
+                ++errcnt;
+                errstr += "Could not open " + args[1] + ".\n";
+            } else {
+                std::vector<uint8_t> profile((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                session.device.restoreProfile(profile, errcnt, errstr);
+            }
+        } else if (command == "wait" && parseFloat(args, 1, value) && args.size() == 2 && value >= 0) {
+            std::this_thread::sleep_for(std::chrono::microseconds(static_cast<long>(value * 1000)));
+        } else {
+            retval = false;
+        }
+    }
+    return retval;
+}
+
+// Splits a line into commands (separated by semicolons) and these into arguments, ignoring comments
+static std::vector<std::vector<std::string>> split(const std::string &line)
+{
+    std::vector<std::vector<std::string>> commands;
+    std::string code = line.substr(0, line.find('#'));
+    std::istringstream lineStream(code);
+    std::string segment;
+    while (std::getline(lineStream, segment, ';')) {
+        std::istringstream segmentStream(segment);
+        std::vector<std::string> args;
+        std::string arg;
+        while (segmentStream >> arg) {
+            args.push_back(arg);
+        }
+        if (!args.empty()) {
+            commands.push_back(args);
+        }
+    }
+    return commands;
+}
+
+// Runs all commands from the given stream, stopping at the first error
+static int run(Session &session, std::istream &input, const std::string &source)
+{
+    int err_level = EXIT_SUCCESS;
+    std::string line;
+    size_t lineNumber = 0;
+    while (err_level == EXIT_SUCCESS && std::getline(input, line)) {
+        ++lineNumber;
+        std::vector<std::vector<std::string>> commands = split(line);
+        for (size_t i = 0; i < commands.size() && err_level == EXIT_SUCCESS; ++i) {
+            int errcnt = 0;
+            std::string errstr;
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            bool valid = execute(session, commands[i], errcnt, errstr);
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (!valid) {
+                std::cerr << source << ":" << lineNumber << ": Invalid command or arguments: " << commands[i][0] << std::endl;
+                err_level = EXIT_FAILURE;
+            } else if (errcnt > 0) {
+                std::cerr << source << ":" << lineNumber << ": Error executing " << commands[i][0] << ":\n" << errstr;
+                err_level = EXIT_FAILURE;
+            } else if (session.timing) {
+                std::cerr << commands[i][0] << ": " << std::fixed << std::setprecision(3) << elapsed << " ms" << std::endl;
+            }
+            if (session.device.disconnected()) {
+                std::cerr << "Device disconnected.\n";
+                err_level = EXIT_FAILURE;
+            }
+        }
+    }
+    return err_level;
+}
+
+// Prints the usage of the program
+static void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [options] [command [args] [; command [args] ...]]\n"
+              << "Options:\n"
+              << "  -s SERIAL  Use the GF2 device having the given serial number\n"
+              << "  -f FILE    Read commands from FILE, one or more per line (use - for stdin)\n"
+              << "  -c FILE    Apply the frequency calibration saved in FILE for the device\n"
+              << "  -t         Print the time taken by each command\n"
+              << "  -n         Run against the simulator, without hardware\n"
+              << "Commands:\n"
+              << "  open [SERIAL]                      Open a device (done implicitly on first use)\n"
+              << "  close                              Close the device\n"
+              << "  clear                              Reset the generator and clear all registers\n"
+              << "  freq SEL KHZ                       Set frequency register SEL (0 or 1)\n"
+              << "  phase SEL DEG                      Set phase register SEL (0 or 1)\n"
+              << "  amp VPP                            Set the amplitude\n"
+              << "  wave sine|triangle                 Set the waveform\n"
+              << "  fsel SEL / psel SEL                Select the frequency or phase register\n"
+              << "  start / stop                       Start or stop the waveform generation\n"
+              << "  sweep START STOP STEP DWELL_MS     Sweep the frequency, in KHz\n"
+              << "  measure GATE_MS DIVIDER            Measure the frequency, routed to GPIO.4 through DIVIDER\n"
+              << "  save FILE / restore FILE           Save or restore the state of the device as a profile\n"
+              << "  wait MS                            Wait the given time\n"
+              << "Commands given on the command line are run before any read from FILE.\n";
+}
+
+int main(int argc, char **argv)
+{
+    CP2130Sim simulator;
+    Session session;  // Not brace-initialized, since GF2Device is not copyable
+    session.simulator = nullptr;
+    session.timing = false;
+    std::string file;
+    std::string commands;
+    int err_level = EXIT_SUCCESS;
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-' && argv[i][1] != '\0' && err_level == EXIT_SUCCESS; ++i) {
+        std::string option = argv[i];
+        if (option == "-s" && i + 1 < argc) {
+            session.serial = argv[++i];
+        } else if (option == "-f" && i + 1 < argc) {
+            file = argv[++i];
+        } else if (option == "-c" && i + 1 < argc) {
+            session.calibration = argv[++i];
+        } else if (option == "-t") {
+            session.timing = true;
+        } else if (option == "-n") {
+            session.simulator = &simulator;
+        } else {
+            err_level = EXIT_FAILURE;
+        }
+    }
+    for (; i < argc; ++i) {
+        commands += std::string(argv[i]) + " ";
+    }
+    if (err_level != EXIT_SUCCESS || (commands.empty() && file.empty())) {
+        printUsage(argv[0]);
+        err_level = EXIT_FAILURE;
+    } else {
+        simulator.setUSBConfig({GF2Device::VID, GF2Device::PID, 0x01, 0x00, 0x32, CP2130::PMBUSREGEN, CP2130::PRIOWRITE});
+        std::istringstream commandStream(commands);
+        err_level = run(session, commandStream, "command line");
+        if (err_level == EXIT_SUCCESS && !file.empty()) {
+            if (file == "-") {
+                err_level = run(session, std::cin, "stdin");
+            } else {
+                std::ifstream fileStream(file);
+                if (!fileStream) {
+                    std::cerr << "Error: Could not open " << file << ".\n";
+                    err_level = EXIT_FAILURE;
+                } else {
+                    err_level = run(session, fileStream, file);
+                }
+            }
+        }
+        session.device.close();
+    }
+    return err_level;
+}
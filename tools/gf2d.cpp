@@ -0,0 +1,585 @@
+/* GF2 daemon - Version 1.0.0
+   Requires GF2 device class version 1.1.0 or later, GF2 protocol class version 1.0.0 or later and CP2130 simulator class version 1.0.0 or later
+   Copyright (c) 2026 Samuel Lourenço
+
+   This program is free software: you can redistribute it and/or modify it
+   under the terms of the GNU General Public License as published by the Free
+   Software Foundation, either version 3 of the License, or (at your option)
+   any later version.
+
+   This program is distributed in the hope that it will be useful, but WITHOUT
+   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+   more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+   Please feel free to contact me via e-mail: samuel.fmlourenco@gmail.com */
+
+
+// Includes
+#include <atomic>
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <libusb-1.0/libusb.h>
+#include "cp2130sim.h"
+#include "gf2device.h"
+#include "gf2protocol.h"
+#include "gf2ring.h"
+
+// Definitions
+const char SOCKET_PATH[] = "/tmp/gf2d.sock";  // Default path of the Unix domain socket
+const int POLL_TIMEOUT = 200;                 // Timeout of each poll, in milliseconds (also bounds the time taken to react to a termination signal)
+const size_t READ_SIZE = 4096;                // Maximum number of bytes read from a client at once
+const size_t OUTPUT_LIMIT = 1048576;          // Maximum number of bytes waiting to be sent to a client, beyond which the client is dropped
+const uint32_t RING_CAPACITY = 256;           // Capacity of each shared-memory ring
+const int RING_SPINS = 10000;                 // Number of empty polls of the rings before the ring thread starts sleeping between polls
+const int RING_IDLE_SLEEP = 50;               // Sleep between polls of idle rings, in microseconds
+
+// A connected client
+// The socket is only closed once no pending job references the client, so that its descriptor cannot be reused while responses are still due
+struct Client {
+    int fd;
+    std::mutex writeMutex;        // Guards the output, which is appended to by different device workers
+    std::vector<uint8_t> output;  // Bytes of responses that could not be sent yet, since the socket buffer was full
+    std::atomic<bool> connected;  // Cleared once the client hangs up, so that pending responses are discarded
+    std::vector<uint8_t> input;   // Bytes received, not yet forming a complete request
+
+    explicit Client(int fd) : fd(fd), writeMutex(), output(), connected(true), input() {}
+    ~Client() { close(fd); }
+};
+
+// A request waiting to be executed, along with the client that sent it
+struct Job {
+    std::shared_ptr<Client> client;
+    GF2Protocol::Request request;
+};
+
+// Owner of a single device, executing its requests on a dedicated thread
+// Requests are executed in the order they were received, and all requests queued in the meantime are executed as one batch
+struct Worker {
+    uint16_t index;
+    std::string serial;
+    CP2130Sim *simulator;        // If not null, the device is simulated
+    GF2Device device;
+    std::atomic<bool> connected;
+    std::mutex deviceMutex;  // Held while the device is in use, since requests from shared-memory rings bypass the queue
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Job> queue;
+    bool stopping;
+    std::thread thread;
+};
+
+static volatile std::sig_atomic_t terminating = 0;
+static std::mutex workersMutex;  // Guards additions to the list of workers, which the ring thread reads concurrently
+static int wakePipe[2] = {-1, -1};  // Written by device workers to wake the main loop, when a client has output pending
+static bool rescanPending = false;  // Set when a device arrives, so that the next listing rescans for devices
+
+// Handles SIGINT and SIGTERM, by requesting the daemon to terminate
+static void signalHandler(int)
+{
+    terminating = 1;
+}
+
+// Handles device arrivals, by flagging that a rescan is due
+static int LIBUSB_CALL hotplugCallback(libusb_context *, libusb_device *, libusb_hotplug_event, void *)
+{
+    rescanPending = true;
+    return 0;  // Keep the callback registered
+}
+
+// Sends as much of the output of the given client as possible, without blocking
+// Note that the write mutex of the client must be held
+static void flushOutput(Client &client)
+{
+    size_t offset = 0;
+    bool blocked = false;
+    while (client.connected && !blocked && offset < client.output.size()) {
+        ssize_t sent = send(client.fd, client.output.data() + offset, client.output.size() - offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent >= 0) {
+            offset += static_cast<size_t>(sent);
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            blocked = true;  // The remainder is sent by the main loop, once the socket becomes writable
+        } else if (errno != EINTR) {
+            client.connected = false;
+        }
+    }
+    if (client.connected) {
+        client.output.erase(client.output.begin(), client.output.begin() + static_cast<long>(offset));
+    } else {
+        client.output.clear();
+    }
+}
+
+// Queues the given buffer for sending to the client, and sends as much of it as possible right away
+// Since sending never blocks, a slow or stalled client cannot hold up the device worker, and thus the other clients of the same device
+// A client that lets its output grow beyond "OUTPUT_LIMIT" [1MB] is dropped
+static void sendAll(Client &client, const std::vector<uint8_t> &buffer)
+{
+    bool pending;
+    {
+        std::lock_guard<std::mutex> lock(client.writeMutex);
+        if (client.connected && client.output.size() + buffer.size() > OUTPUT_LIMIT) {
+            client.connected = false;
+            client.output.clear();
+            shutdown(client.fd, SHUT_RDWR);
+        } else if (client.connected) {
+            client.output.insert(client.output.end(), buffer.begin(), buffer.end());
+            flushOutput(client);
+        }
+        pending = !client.output.empty();
+    }
+    if (pending) {
+        uint8_t byte = 0;
+        ssize_t written = write(wakePipe[1], &byte, 1);  // If the pipe is full, the main loop is already due to wake up
+        static_cast<void>(written);
+    }
+}
+
+// Appends an encoded response, along with its payload, to the given buffer
+static void appendResponse(std::vector<uint8_t> &buffer, const GF2Protocol::Request &request, int16_t status, uint32_t value, const std::string &payload)
+{
+    size_t length = payload.size() > GF2Protocol::MAX_PAYLOAD ? GF2Protocol::MAX_PAYLOAD : payload.size();
+    GF2Protocol::Response response = {request.opcode, request.id, status, static_cast<uint16_t>(length), value};
+    size_t offset = buffer.size();
+    buffer.resize(offset + GF2Protocol::RESPONSE_SIZE + length);
+    GF2Protocol::encodeResponse(response, buffer.data() + offset);
+    std::memcpy(buffer.data() + offset + GF2Protocol::RESPONSE_SIZE, payload.data(), length);
+}
+
+// Opens the device of the given worker (or reopens it, after a disconnect) and sets up both SPI channels
+static void openDevice(Worker &worker)
+{
+    worker.device.close();
+    int result = worker.simulator != nullptr ? worker.device.open(worker.simulator) : worker.device.open(worker.serial);
+    if (result == GF2Device::SUCCESS) {
+        int errcnt = 0;
+        std::string errstr;
+        worker.device.setupChannel0(errcnt, errstr);
+        worker.device.setupChannel1(errcnt, errstr);
+    }
+    worker.connected = worker.device.isOpen() && !worker.device.disconnected();
+}
+
+// Executes a single request on the device of the given worker, appending the response to the given buffer
+static void execute(Worker &worker, const GF2Protocol::Request &request, std::vector<uint8_t> &buffer)
+{
+    GF2Device &device = worker.device;
+    int errcnt = 0;
+    std::string errstr;
+    int16_t status = GF2Protocol::STOK;
+    uint32_t value = 0;
+    if (!worker.connected) {
+        status = GF2Protocol::STDISCONNECTED;
+    } else {
+        switch (request.opcode) {
+            case GF2Protocol::OPCLEAR:
+                device.clear(errcnt, errstr);
+                break;
+            case GF2Protocol::OPFREQ:
+                if (request.selection > 1 || !(request.value >= GF2Device::FREQUENCY_MIN && request.value <= GF2Device::FREQUENCY_MAX)) {  // Also rejects NaN
+                    status = GF2Protocol::STARGUMENT;
+                } else {
+                    device.setFrequency(request.selection == 1, request.value, errcnt, errstr);
+                }
+                break;
+            case GF2Protocol::OPPHASE:
+                if (request.selection > 1 || !std::isfinite(request.value)) {
+                    status = GF2Protocol::STARGUMENT;
+                } else {
+                    device.setPhase(request.selection == 1, request.value, errcnt, errstr);
+                }
+                break;
+            case GF2Protocol::OPAMP:
+                if (!(request.value >= GF2Device::AMPLITUDE_MIN && request.value <= GF2Device::AMPLITUDE_MAX)) {
+                    status = GF2Protocol::STARGUMENT;
+                } else {
+                    device.setAmplitude(request.value, errcnt, errstr);
+                }
+                break;
+            case GF2Protocol::OPWAVE:
+                if (request.selection > 1) {
+                    status = GF2Protocol::STARGUMENT;
+                } else if (request.selection == 0) {
+                    device.setSineWave(errcnt, errstr);
+                } else {
+                    device.setTriangleWave(errcnt, errstr);
+                }
+                break;
+            case GF2Protocol::OPFSEL:
+            case GF2Protocol::OPPSEL:
+                if (request.selection > 1) {
+                    status = GF2Protocol::STARGUMENT;
+                } else if (request.opcode == GF2Protocol::OPFSEL) {
+                    device.selectFrequency(request.selection == 1, errcnt, errstr);
+                } else {
+                    device.selectPhase(request.selection == 1, errcnt, errstr);
+                }
+                break;
+            case GF2Protocol::OPSTART:
+                device.start(errcnt, errstr);
+                break;
+            case GF2Protocol::OPSTOP:
+                device.stop(errcnt, errstr);
+                break;
+            case GF2Protocol::OPSTATUS: {
+                GF2Device::Status deviceStatus = device.getStatus(errcnt, errstr);
+                value = (deviceStatus.clock ? GF2Protocol::STBMCLOCK : 0) |
+                        (deviceStatus.dac ? GF2Protocol::STBMDAC : 0) |
+                        (deviceStatus.waveGen ? GF2Protocol::STBMWAVEGEN : 0) |
+                        (deviceStatus.fsel ? GF2Protocol::STBMFSEL : 0) |
+                        (deviceStatus.psel ? GF2Protocol::STBMPSEL : 0);
+                break;
+            }
+            default:
+                status = GF2Protocol::STPROTOCOL;
+        }
+        if (errcnt > 0) {
+            status = device.disconnected() ? GF2Protocol::STDISCONNECTED : GF2Protocol::STIO;
+            worker.connected = !device.disconnected();
+        }
+    }
+    appendResponse(buffer, request, status, value, status == GF2Protocol::STIO ? errstr : std::string());
+}
+
+// Thread procedure of each worker
+static void runWorker(Worker &worker)
+{
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while (!worker.stopping) {
+        if (worker.queue.empty()) {
+            worker.condition.wait(lock);
+        } else {
+            std::deque<Job> batch;
+            batch.swap(worker.queue);  // All queued requests are taken at once, so that clients can keep queueing while the batch executes
+            lock.unlock();
+            std::map<Client *, std::pair<std::shared_ptr<Client>, std::vector<uint8_t>>> responses;
+            {
+                std::lock_guard<std::mutex> deviceLock(worker.deviceMutex);
+                if (!worker.connected) {
+                    openDevice(worker);  // A device that was disconnected is reopened before executing a new batch
+                }
+                for (const Job &job : batch) {
+                    if (job.client->connected) {
+                        std::pair<std::shared_ptr<Client>, std::vector<uint8_t>> &entry = responses[job.client.get()];
+                        entry.first = job.client;
+                        execute(worker, job.request, entry.second);
+                    }
+                }
+            }
+            for (auto &entry : responses) {
+                sendAll(*entry.second.first, entry.second.second);  // One write per client and batch
+            }
+            lock.lock();
+        }
+    }
+}
+
+// Adds a worker for the given device, starting its thread
+static void addWorker(std::vector<std::unique_ptr<Worker>> &workers, const std::string &serial, CP2130Sim *simulator)
+{
+    std::unique_ptr<Worker> worker(new Worker);
+    worker->index = static_cast<uint16_t>(workers.size());
+    worker->serial = serial;
+    worker->simulator = simulator;
+    worker->stopping = false;
+    openDevice(*worker);
+    Worker &ref = *worker;
+    worker->thread = std::thread([&ref]() { runWorker(ref); });
+    std::lock_guard<std::mutex> lock(workersMutex);
+    workers.push_back(std::move(worker));
+}
+
+// Thread procedure serving the shared-memory rings
+// Requests are executed right away on the calling thread, so that no system calls are made in the steady state, other than those of the transfers themselves
+static void runRings(std::vector<std::unique_ptr<GF2Ring>> &rings, std::vector<std::unique_ptr<Worker>> &workers)
+{
+    int idle = 0;
+    while (!terminating) {
+        bool served = false;
+        for (const auto &ring : rings) {
+            GF2Protocol::Request request;
+            while (ring->popRequest(request)) {
+                served = true;
+                GF2Protocol::Response response = {request.opcode, request.id, GF2Protocol::STOK, 0, 0};
+                Worker *worker = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(workersMutex);
+                    if (request.opcode == GF2Protocol::OPNONE) {
+                        response.status = GF2Protocol::STPROTOCOL;  // Malformed request, completed nonetheless so that the client does not wait forever
+                    } else if (request.opcode == GF2Protocol::OPLIST) {
+                        response.value = static_cast<uint32_t>(workers.size());  // Only the count is returned, since completions carry no payload
+                    } else if (request.device >= workers.size()) {
+                        response.status = GF2Protocol::STNODEVICE;
+                    } else {
+                        worker = workers[request.device].get();  // Workers are never removed while the daemon runs, so the pointer stays valid
+                    }
+                }
+                if (worker != nullptr) {
+                    std::lock_guard<std::mutex> deviceLock(worker->deviceMutex);
+                    if (!worker->connected) {
+                        openDevice(*worker);
+                    }
+                    std::vector<uint8_t> buffer;
+                    execute(*worker, request, buffer);
+                    GF2Protocol::decodeResponse(buffer.data(), response);
+                    response.length = 0;  // The error string, if any, is dropped
+                }
+                while (!ring->pushCompletion(response) && !terminating) {  // The client is expected to drain its completions, which is waited for without holding any locks, so that a stalled client cannot block the other clients
+                    std::this_thread::yield();
+                }
+            }
+        }
+        if (served) {
+            idle = 0;
+        } else if (idle < RING_SPINS) {
+            ++idle;
+            std::this_thread::yield();  // Lets the client run, should both share the same core
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(RING_IDLE_SLEEP));
+        }
+    }
+}
+
+// Scans for devices that are not yet owned by the daemon, adding a worker for each one found
+static void rescan(std::vector<std::unique_ptr<Worker>> &workers)
+{
+    int errcnt = 0;
+    std::string errstr;
+    std::list<std::string> serials = GF2Device::listDevices(errcnt, errstr);
+    for (const std::string &serial : serials) {
+        bool known = false;
+        for (const auto &worker : workers) {
+            known = known || worker->serial == serial;
+        }
+        if (!known) {
+            addWorker(workers, serial, nullptr);
+        }
+    }
+}
+
+// Dispatches every complete request received from the given client
+// The device list is only rescanned if a device arrived since the last listing, or if the client asks for it, since scanning opens every device
+static void dispatch(const std::shared_ptr<Client> &client, std::vector<std::unique_ptr<Worker>> &workers, bool simulated)
+{
+    size_t offset = 0;
+    while (client->connected && client->input.size() - offset >= GF2Protocol::REQUEST_SIZE) {
+        GF2Protocol::Request request;
+        if (!GF2Protocol::decodeRequest(client->input.data() + offset, request)) {
+            client->connected = false;  // The stream cannot be resynchronized, so the client is dropped
+            shutdown(client->fd, SHUT_RDWR);
+        } else if (request.opcode == GF2Protocol::OPLIST) {
+            if (!simulated && (rescanPending || request.selection == 1)) {
+                rescanPending = false;
+                rescan(workers);
+            }
+            std::vector<GF2Protocol::DeviceEntry> entries;
+            for (const auto &worker : workers) {
+                entries.push_back({worker->index, worker->connected, worker->serial});
+            }
+            std::vector<uint8_t> payload = GF2Protocol::encodeDeviceList(entries);
+            std::vector<uint8_t> buffer;
+            appendResponse(buffer, request, GF2Protocol::STOK, static_cast<uint32_t>(entries.size()), std::string(payload.begin(), payload.end()));
+            sendAll(*client, buffer);
+        } else if (request.device >= workers.size()) {
+            std::vector<uint8_t> buffer;
+            appendResponse(buffer, request, GF2Protocol::STNODEVICE, 0, std::string());
+            sendAll(*client, buffer);
+        } else {
+            Worker &worker = *workers[request.device];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.queue.push_back({client, request});
+            worker.condition.notify_one();
+        }
+        offset += GF2Protocol::REQUEST_SIZE;
+    }
+    client->input.erase(client->input.begin(), client->input.begin() + offset);
+}
+
+// Prints the usage of the program
+static void printUsage(const char *program)
+{
+    std::cerr << "Usage: " << program << " [-s SOCKET] [-n COUNT] [-r NAME ...]\n"
+              << "  -s SOCKET  Path of the Unix domain socket (default: " << SOCKET_PATH << ")\n"
+              << "  -n COUNT   Serve the given number of simulated devices, instead of real hardware\n"
+              << "  -r NAME    Also serve a client via a shared-memory ring with the given name (e.g., /gf2ring), may be repeated\n";
+}
+
+int main(int argc, char **argv)
+{
+    std::string path = SOCKET_PATH;
+    int simulated = 0;
+    std::vector<std::string> ringNames;
+    int err_level = EXIT_SUCCESS;
+    for (int i = 1; i < argc && err_level == EXIT_SUCCESS; ++i) {
+        std::string option = argv[i];
+        if (option == "-s" && i + 1 < argc) {
+            path = argv[++i];
+        } else if (option == "-n" && i + 1 < argc) {
+            simulated = std::atoi(argv[++i]);
+        } else if (option == "-r" && i + 1 < argc) {
+            ringNames.push_back(argv[++i]);
+        } else {
+            printUsage(argv[0]);
+            err_level = EXIT_FAILURE;
+        }
+    }
+    sockaddr_un address = sockaddr_un();
+    address.sun_family = AF_UNIX;
+    int listener = -1;
+    struct stat status;
+    if (err_level == EXIT_SUCCESS) {
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Error: Socket path is too long.\n";
+            err_level = EXIT_FAILURE;
+        } else if (lstat(path.c_str(), &status) == 0 && !S_ISSOCK(status.st_mode)) {  // Guards against deleting some other file, given by mistake
+            std::cerr << "Error: " << path << " exists and is not a socket.\n";
+            err_level = EXIT_FAILURE;
+        } else {
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+            unlink(path.c_str());  // Removes a stale socket left by a previous instance
+            listener = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listener < 0 || bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listener, SOMAXCONN) != 0) {
+                std::cerr << "Error: Could not listen on " << path << ": " << std::strerror(errno) << "\n";
+                err_level = EXIT_FAILURE;
+            }
+        }
+    }
+    if (err_level == EXIT_SUCCESS && pipe2(wakePipe, O_NONBLOCK | O_CLOEXEC) != 0) {
+        std::cerr << "Error: Could not create pipe: " << std::strerror(errno) << "\n";
+        err_level = EXIT_FAILURE;
+    }
+    if (err_level == EXIT_SUCCESS) {
+        std::signal(SIGINT, signalHandler);
+        std::signal(SIGTERM, signalHandler);
+        std::vector<std::unique_ptr<CP2130Sim>> simulators;
+        std::vector<std::unique_ptr<Worker>> workers;
+        if (simulated > 0) {
+            for (int i = 0; i < simulated; ++i) {
+                std::string serial = "SIM" + std::to_string(i);
+                simulators.emplace_back(new CP2130Sim);
+                simulators.back()->setSerialDesc(std::u16string(serial.begin(), serial.end()));
+                addWorker(workers, serial, simulators.back().get());
+            }
+        } else {
+            rescan(workers);
+        }
+        std::vector<std::unique_ptr<GF2Ring>> rings;
+        for (const std::string &name : ringNames) {
+            rings.emplace_back(new GF2Ring);
+            if (rings.back()->create(name, RING_CAPACITY) != GF2Ring::SUCCESS) {
+                std::cerr << "Error: Could not create ring " << name << ".\n";
+                err_level = EXIT_FAILURE;
+                terminating = 1;
+            }
+        }
+        std::thread ringThread;
+        if (!rings.empty() && err_level == EXIT_SUCCESS) {
+            ringThread = std::thread([&rings, &workers]() { runRings(rings, workers); });
+        }
+        libusb_context *context = nullptr;
+        libusb_hotplug_callback_handle callback = libusb_hotplug_callback_handle();
+        bool hotplug = simulated == 0 && libusb_init(&context) == 0;
+        hotplug = hotplug && libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG) != 0 && libusb_hotplug_register_callback(context, LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED, 0, GF2Device::VID, GF2Device::PID, LIBUSB_HOTPLUG_MATCH_ANY, hotplugCallback, nullptr, &callback) == LIBUSB_SUCCESS;  // Without hotplug support, rescans only happen on request
+        std::cerr << "Serving " << workers.size() << " device(s) on " << path << std::endl;
+        std::vector<std::shared_ptr<Client>> clients;
+        while (!terminating) {
+            std::vector<pollfd> fds;
+            fds.push_back({listener, POLLIN, 0});
+            fds.push_back({wakePipe[0], POLLIN, 0});
+            for (const auto &client : clients) {
+                std::lock_guard<std::mutex> lock(client->writeMutex);
+                fds.push_back({client->fd, static_cast<short>(POLLIN | (client->output.empty() ? 0 : POLLOUT)), 0});
+            }
+            if (poll(fds.data(), fds.size(), POLL_TIMEOUT) > 0) {
+                if ((fds[1].revents & POLLIN) != 0) {
+                    uint8_t buffer[READ_SIZE];
+                    while (read(wakePipe[0], buffer, sizeof(buffer)) > 0) {  // Only serves to wake up, so that the output of each client is polled for
+                    }
+                }
+                for (size_t i = 2; i < fds.size(); ++i) {
+                    std::shared_ptr<Client> &client = clients[i - 2];
+                    if ((fds[i].revents & POLLOUT) != 0) {
+                        std::lock_guard<std::mutex> lock(client->writeMutex);
+                        flushOutput(*client);
+                    }
+                    if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0) {
+                        uint8_t buffer[READ_SIZE];
+                        ssize_t received = recv(client->fd, buffer, sizeof(buffer), 0);
+                        if (received <= 0) {
+                            client->connected = false;
+                        } else {
+                            client->input.insert(client->input.end(), buffer, buffer + received);
+                            dispatch(client, workers, simulated > 0);
+                        }
+                    }
+                }
+                for (size_t i = clients.size(); i > 0; --i) {
+                    if (!clients[i - 1]->connected) {
+                        clients.erase(clients.begin() + static_cast<long>(i - 1));  // The socket is closed once pending jobs are done with it
+                    }
+                }
+                if ((fds[0].revents & POLLIN) != 0) {
+                    int fd = accept(listener, nullptr, nullptr);
+                    if (fd >= 0) {
+                        clients.emplace_back(new Client(fd));
+                    }
+                }
+            }
+            if (hotplug) {
+                timeval tv = {0, 0};
+                libusb_handle_events_timeout_completed(context, &tv, nullptr);  // Calls hotplugCallback() for any devices that arrived
+            }
+        }
+        if (hotplug) {
+            libusb_hotplug_deregister_callback(context, callback);
+        }
+        if (context != nullptr) {
+            libusb_exit(context);
+        }
+        if (ringThread.joinable()) {
+            ringThread.join();
+        }
+        rings.clear();  // Also removes the shared memory
+        for (const auto &worker : workers) {
+            {
+                std::lock_guard<std::mutex> lock(worker->mutex);
+                worker->stopping = true;
+                worker->condition.notify_one();
+            }
+            worker->thread.join();
+            worker->device.close();
+        }
+        clients.clear();
+        close(listener);
+        unlink(path.c_str());
+    }
+    if (wakePipe[0] >= 0) {
+        close(wakePipe[0]);
+        close(wakePipe[1]);
+    }
+    return err_level;
+}